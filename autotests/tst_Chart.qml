@@ -0,0 +1,141 @@
+/*
+ * This file is part of Quick Charts.
+ * Copyright 2019 Arjen Hiemstra <ahiemstra@heimr.nl>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License or (at your option) version 3 or any later version
+ * accepted by the membership of KDE e.V. (or its successor approved
+ * by the membership of KDE e.V.), which shall act as a proxy
+ * defined in Section 14 of version 3 of the license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+import QtQuick 2.11
+import QtTest 1.11
+
+import org.kde.quickcharts 1.0 as Charts
+
+TestCase {
+    id: testCase
+    name: "Chart Update Tests"
+    when: windowShown
+
+    Component {
+        id: chartComponent
+
+        Charts.LineChart {
+            id: chart
+
+            property alias values: valueSource.array
+            property alias axis: axisSource
+
+            width: 200
+            height: 200
+            valueSources: Charts.ArraySource { id: valueSource; array: [1, 2, 3] }
+
+            Charts.ChartAxisSource {
+                id: axisSource
+                chart: chart
+                axis: Charts.ChartAxisSource.YAxis
+            }
+        }
+    }
+
+    SignalSpy {
+        id: updateSpy
+        signalName: "dataUpdated"
+    }
+
+    // Create a chart and wait until its initial data has been processed.
+    function createChart() {
+        var chart = createTemporaryObject(chartComponent, testCase)
+        verify(chart)
+
+        updateSpy.clear()
+        updateSpy.target = chart
+        tryVerify(function() { return updateSpy.count > 0 })
+        wait(50)
+        updateSpy.clear()
+
+        return chart
+    }
+
+    function test_coalesce() {
+        var chart = createChart()
+
+        for (var i = 1; i <= 10; ++i) {
+            chart.values = [1, 2, i * 10]
+        }
+
+        tryVerify(function() { return updateSpy.count > 0 })
+        wait(50)
+        compare(updateSpy.count, 1)
+        compare(chart.axis.maximum(), 100)
+    }
+
+    function test_batch() {
+        var chart = createChart()
+
+        chart.beginUpdate()
+        chart.values = [1, 2, 10]
+        chart.beginUpdate()
+        chart.values = [1, 2, 20]
+        chart.endUpdate()
+        chart.values = [1, 2, 30]
+
+        // The outer batch has not ended yet, so nothing is processed.
+        wait(50)
+        compare(updateSpy.count, 0)
+
+        chart.endUpdate()
+
+        tryVerify(function() { return updateSpy.count > 0 })
+        wait(50)
+        compare(updateSpy.count, 1)
+        compare(chart.axis.maximum(), 30)
+    }
+
+    function test_unmatchedEndUpdate() {
+        var chart = createChart()
+
+        ignoreWarning("Chart::endUpdate called without matching beginUpdate")
+        chart.endUpdate()
+
+        // The unmatched call must not leave the chart in a batch.
+        chart.values = [1, 2, 40]
+        tryVerify(function() { return updateSpy.count > 0 })
+        compare(chart.axis.maximum(), 40)
+    }
+
+    function test_maximumUpdateRate() {
+        var chart = createChart()
+        chart.maximumUpdateRate = 5
+
+        // Make sure the last update happened just now.
+        chart.values = [1, 2, 10]
+        tryVerify(function() { return updateSpy.count > 0 }, 1000)
+        updateSpy.clear()
+
+        for (var i = 1; i <= 10; ++i) {
+            chart.values = [1, 2, i * 100]
+            wait(5)
+        }
+
+        // Changes within 200 milliseconds of the last update are delayed.
+        compare(updateSpy.count, 0)
+
+        tryVerify(function() { return updateSpy.count > 0 }, 1000)
+        wait(50)
+        compare(updateSpy.count, 1)
+        compare(chart.axis.maximum(), 1000)
+    }
+}
@@ -0,0 +1,121 @@
+/*
+ * This file is part of Quick Charts.
+ * Copyright 2019 Arjen Hiemstra <ahiemstra@heimr.nl>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License or (at your option) version 3 or any later version
+ * accepted by the membership of KDE e.V. (or its successor approved
+ * by the membership of KDE e.V.), which shall act as a proxy
+ * defined in Section 14 of version 3 of the license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+import QtQuick 2.11
+import QtTest 1.11
+
+import org.kde.quickcharts 1.0 as Charts
+
+TestCase {
+    id: testCase
+    name: "Legend Tests"
+
+    Component {
+        id: sortFilterModel
+
+        Charts.LegendSortFilterModel {
+            sourceModel: Charts.LegendModel {
+                chart: Charts.BarChart {
+                    nameSource: Charts.ArraySource { array: ["banana", "apple", "cherry"] }
+                    valueSources: [
+                        Charts.ArraySource { array: [3] },
+                        Charts.ArraySource { array: [1] },
+                        Charts.ArraySource { array: [2] }
+                    ]
+                }
+            }
+        }
+    }
+
+    Component {
+        id: mixedModel
+
+        Charts.LegendSortFilterModel {
+            sortMode: Charts.LegendSortFilterModel.SortByValue
+            sourceModel: Charts.LegendModel {
+                chart: Charts.BarChart {
+                    nameSource: Charts.ArraySource { array: ["banana", "apple", "cherry", "date"] }
+                    valueSources: [
+                        Charts.ArraySource { array: [3] },
+                        Charts.ArraySource { array: ["n/a"] },
+                        Charts.ArraySource { array: [1] },
+                        Charts.ArraySource { array: ["many"] }
+                    ]
+                }
+            }
+        }
+    }
+
+    function names(model) {
+        var result = []
+        for (var i = 0; i < model.rowCount(); ++i) {
+            result.push(model.data(model.index(i, 0), Charts.LegendModel.NameRole))
+        }
+        return result
+    }
+
+    function test_sortFilter_data() {
+        return [
+            { tag: "unsorted", sortMode: Charts.LegendSortFilterModel.Unsorted, sortOrder: Qt.AscendingOrder, filterText: "",
+              names: ["banana", "apple", "cherry"] },
+            { tag: "name", sortMode: Charts.LegendSortFilterModel.SortByName, sortOrder: Qt.AscendingOrder, filterText: "",
+              names: ["apple", "banana", "cherry"] },
+            { tag: "value descending", sortMode: Charts.LegendSortFilterModel.SortByValue, sortOrder: Qt.DescendingOrder, filterText: "",
+              names: ["banana", "cherry", "apple"] },
+            { tag: "filter", sortMode: Charts.LegendSortFilterModel.Unsorted, sortOrder: Qt.AscendingOrder, filterText: "AN",
+              names: ["banana"] },
+            { tag: "filter sorted", sortMode: Charts.LegendSortFilterModel.SortByName, sortOrder: Qt.DescendingOrder, filterText: "e",
+              names: ["cherry", "apple"] }
+        ]
+    }
+
+    function test_sortFilter(data) {
+        var model = createTemporaryObject(sortFilterModel, testCase)
+        verify(model)
+
+        tryVerify(function() { return model.sourceModel.rowCount() == 3 })
+
+        model.sortMode = data.sortMode
+        model.sortOrder = data.sortOrder
+        model.filterText = data.filterText
+
+        compare(names(model), data.names)
+
+        // Going back to the defaults restores the order of the source model.
+        model.sortMode = Charts.LegendSortFilterModel.Unsorted
+        model.filterText = ""
+
+        compare(names(model), ["banana", "apple", "cherry"])
+    }
+
+    function test_sortMixedValues() {
+        var model = createTemporaryObject(mixedModel, testCase)
+        verify(model)
+
+        tryVerify(function() { return model.sourceModel.rowCount() == 4 })
+
+        // Numbers sort before values that are not numbers.
+        compare(names(model), ["cherry", "banana", "date", "apple"])
+
+        model.sortOrder = Qt.DescendingOrder
+        compare(names(model), ["apple", "date", "banana", "cherry"])
+    }
+}
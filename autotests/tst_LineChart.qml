@@ -44,6 +44,26 @@ TestCase {
         }
     }
 
+    Component {
+        id: ranged
+        Charts.LineChart {
+            id: rangedChart
+
+            property alias values: valueSource.array
+            property alias axis: axisSource
+
+            width: 200
+            height: 200
+            valueSources: Charts.ArraySource { id: valueSource }
+
+            Charts.ChartAxisSource {
+                id: axisSource
+                chart: rangedChart
+                axis: Charts.ChartAxisSource.YAxis
+            }
+        }
+    }
+
     function test_create_data() {
         return [
             { tag: "minimal", component: minimal },
@@ -55,4 +75,53 @@ TestCase {
         var item = createTemporaryObject(data.component, testCase)
         verify(item)
     }
+
+    function test_range_data() {
+        return [
+            { tag: "default", niceBounds: false, hysteresis: 0.0, steps: [
+                { values: [1, 47], maximum: 47 },
+                { values: [1, 30], maximum: 30 }
+            ] },
+            { tag: "niceBounds", niceBounds: true, hysteresis: 0.0, steps: [
+                { values: [1, 47], maximum: 50 },
+                { values: [1, 123], maximum: 140 },
+                { values: [0.1, 0.73], maximum: 0.8 }
+            ] },
+            { tag: "hysteresis", niceBounds: false, hysteresis: 0.2, steps: [
+                { values: [1, 100], maximum: 100 },
+                // Grows with 20% headroom.
+                { values: [1, 150], maximum: 180 },
+                // Still uses more than 80% of the range, so it is kept.
+                { values: [1, 160], maximum: 180 },
+                // Uses less than 80% of the range, so it shrinks.
+                { values: [1, 100], maximum: 100 }
+            ] }
+        ]
+    }
+
+    SignalSpy {
+        id: updateSpy
+        signalName: "dataUpdated"
+    }
+
+    function test_range(data) {
+        var item = createTemporaryObject(ranged, testCase)
+        verify(item)
+
+        item.yRange.niceBounds = data.niceBounds
+        item.yRange.hysteresis = data.hysteresis
+
+        updateSpy.target = item
+
+        // Values are set before the chart processes anything, so the first
+        // step is the first range the chart computes.
+        for (var i = 0; i < data.steps.length; ++i) {
+            updateSpy.clear()
+            item.values = data.steps[i].values
+            tryVerify(function() { return updateSpy.count > 0 })
+
+            compare(item.axis.minimum(), 0)
+            fuzzyCompare(item.axis.maximum(), data.steps[i].maximum, 1e-4)
+        }
+    }
 }
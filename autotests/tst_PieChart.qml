@@ -44,10 +44,24 @@ TestCase {
         }
     }
 
+    Component {
+        id: aggregated
+        Charts.PieChart {
+            width: 200
+            height: 200
+            maximumSlices: 2
+            otherColor: "gray"
+            nameSource: Charts.ArraySource { array: ["Test 1", "Test 2", "Test 3", "Test 4", "Test 5"] }
+            colorSource: Charts.ArraySource { array: ["red", "green", "blue", "yellow", "cyan"] }
+            valueSources: Charts.ArraySource { array: [1, 5, 3, 4, 2] }
+        }
+    }
+
     function test_create_data() {
         return [
             { tag: "minimal", component: minimal },
-            { tag: "simple", component: simple }
+            { tag: "simple", component: simple },
+            { tag: "aggregated", component: aggregated }
         ]
     }
 
@@ -55,5 +69,31 @@ TestCase {
         var item = createTemporaryObject(data.component, testCase)
         verify(item)
     }
+
+    Component {
+        id: legendModel
+        Charts.LegendModel { sourceIndex: 0 }
+    }
+
+    function test_aggregation() {
+        var item = createTemporaryObject(aggregated, testCase)
+        verify(item)
+
+        // The two largest items, in their original order, followed by "other".
+        tryVerify(function() { return item.sliceIndices(0).length == 3 })
+        var slices = item.sliceIndices(0)
+        compare(slices[0], 1)
+        compare(slices[1], 3)
+        compare(slices[2], -1)
+        compare(item.otherValue(0), 6)
+
+        var model = createTemporaryObject(legendModel, testCase, { chart: item })
+        verify(model)
+        tryVerify(function() { return model.rowCount() == 3 })
+        var other = model.index(2, 0)
+        compare(model.data(other, Charts.LegendModel.NameRole), "Other")
+        compare(model.data(other, Charts.LegendModel.ColorRole), Qt.color("gray"))
+        compare(model.data(other, Charts.LegendModel.ValueRole), 6)
+    }
 }
 
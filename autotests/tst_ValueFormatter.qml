@@ -0,0 +1,68 @@
+/*
+ * This file is part of Quick Charts.
+ * Copyright 2019 Arjen Hiemstra <ahiemstra@heimr.nl>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License or (at your option) version 3 or any later version
+ * accepted by the membership of KDE e.V. (or its successor approved
+ * by the membership of KDE e.V.), which shall act as a proxy
+ * defined in Section 14 of version 3 of the license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+import QtQuick 2.11
+import QtTest 1.11
+
+import org.kde.quickcharts 1.0 as Charts
+
+TestCase {
+    id: testCase
+    name: "Value Formatter Tests"
+
+    Component {
+        id: formatter
+        Charts.ValueFormatter { localeName: "C" }
+    }
+
+    function test_format_data() {
+        return [
+            { tag: "plain", properties: {}, value: 1500, result: "1500" },
+            { tag: "not a number", properties: {}, value: "abc", result: "abc" },
+            { tag: "unit", properties: { unit: "%" }, value: 50, result: "50 %" },
+            { tag: "metric", properties: { unit: "B", prefix: Charts.ValueFormatter.MetricPrefix }, value: 1500, result: "1.5 kB" },
+            { tag: "metric small", properties: { unit: "s", prefix: Charts.ValueFormatter.MetricPrefix }, value: 0.25, result: "250 ms" },
+            { tag: "binary", properties: { unit: "B", prefix: Charts.ValueFormatter.BinaryPrefix }, value: 2048, result: "2 KiB" },
+            { tag: "decimals", properties: { decimals: 1 }, value: 1234.5678, result: "1234.6" },
+            { tag: "decimals padded", properties: { decimals: 2 }, value: 3, result: "3.00" },
+            { tag: "decimals and prefix", properties: { decimals: 2, unit: "B", prefix: Charts.ValueFormatter.MetricPrefix }, value: 1234567, result: "1.23 MB" },
+            { tag: "locale", properties: { decimals: 2, localeName: "nl_NL" }, value: 2.5, result: "2,50" }
+        ]
+    }
+
+    function test_format(data) {
+        var item = createTemporaryObject(formatter, testCase, data.properties)
+        verify(item)
+        compare(item.format(data.value), data.result)
+    }
+
+    function test_formatChanged() {
+        var item = createTemporaryObject(formatter, testCase)
+        verify(item)
+        compare(item.format(1500), "1500")
+
+        item.prefix = Charts.ValueFormatter.MetricPrefix
+        compare(item.format(1500), "1.5 k")
+
+        item.unit = "B"
+        compare(item.format(1500), "1.5 kB")
+    }
+}
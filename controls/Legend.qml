@@ -43,6 +43,13 @@ Control {
     property int sourceIndex: -1
 
     property var formatValue: function(input) { return input }
+    /**
+     * A formatter to use for values instead of formatValue.
+     *
+     * This formats values in C++, which is a lot cheaper for legends with
+     * many items that update frequently.
+     */
+    property Charts.ValueFormatter formatter: null
 
     property bool valueVisible: false
     property real valueWidth: -1
@@ -76,7 +83,7 @@ Control {
 
         Repeater {
             id: legendRepeater
-            model: Charts.LegendModel { id: legendModel; chart: control.chart; sourceIndex: control.sourceIndex }
+            model: Charts.LegendModel { id: legendModel; chart: control.chart; sourceIndex: control.sourceIndex; formatter: control.formatter }
 
             delegate: LegendDelegate {
                 Layout.preferredWidth: implicitWidth
@@ -84,7 +91,12 @@ Control {
                 property var itemData: typeof modelData !== "undefined" ? modelData : model
                 name: itemData[control.nameRole] !== undefined ? itemData[control.nameRole] : ""
                 color: itemData[control.colorRole] !== undefined ? itemData[control.colorRole] : "white"
-                value: itemData[control.valueRole] !== undefined ? control.formatValue(itemData[control.valueRole]) : ""
+                value: {
+                    if (control.formatter && itemData.formattedValue !== undefined) {
+                        return itemData.formattedValue
+                    }
+                    return itemData[control.valueRole] !== undefined ? control.formatValue(itemData[control.valueRole]) : ""
+                }
 
                 colorVisible: control.colorVisible
                 colorWidth: control.colorWidth
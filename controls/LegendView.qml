@@ -0,0 +1,132 @@
+/*
+ * This file is part of Quick Charts.
+ * Copyright 2019 Arjen Hiemstra <ahiemstra@heimr.nl>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License or (at your option) version 3 or any later version
+ * accepted by the membership of KDE e.V. (or its successor approved
+ * by the membership of KDE e.V.), which shall act as a proxy
+ * defined in Section 14 of version 3 of the license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+import QtQuick 2.9
+import QtQuick.Controls 2.2
+
+import org.kde.quickcharts 1.0 as Charts
+import org.kde.quickcharts.controls 1.0
+
+/**
+ * A legend control that only creates delegates for visible items.
+ *
+ * Unlike Legend, this uses a ListView, so it can be used for charts with a
+ * large amount of items. Items can be sorted and filtered using sortMode,
+ * sortOrder and filterText, which does not require recreating the model.
+ */
+Control {
+    id: control
+
+    /**
+     * The chart to display the legend for.
+     */
+    property Charts.Chart chart
+    /**
+     * The index of the value source to display values of.
+     *
+     * If -1, the default, the first value of each value source is displayed.
+     */
+    property int sourceIndex: -1
+
+    /**
+     * How to sort items, see LegendSortFilterModel.sortMode.
+     */
+    property alias sortMode: sortFilterModel.sortMode
+    /**
+     * The order to sort items in.
+     */
+    property alias sortOrder: sortFilterModel.sortOrder
+    /**
+     * Only display items whose name contains this text.
+     */
+    property alias filterText: sortFilterModel.filterText
+
+    /**
+     * The model providing the items to sort and filter.
+     *
+     * Defaults to a LegendModel for chart and sourceIndex.
+     */
+    property alias sourceModel: sortFilterModel.sourceModel
+    property alias delegate: list.delegate
+    property alias orientation: list.orientation
+
+    property var formatValue: function(input) { return input }
+    /**
+     * A formatter to use for values instead of formatValue.
+     *
+     * This formats values in C++, which is a lot cheaper for legends with
+     * many items that update frequently.
+     */
+    property Charts.ValueFormatter formatter: null
+
+    property bool valueVisible: false
+    property real valueWidth: -1
+    property bool colorVisible: true
+    property real colorWidth: Theme.smallSpacing
+
+    property Component indicator: null
+
+    leftPadding: 0
+    rightPadding: 0
+    topPadding: 0
+    bottomPadding: 0
+
+    implicitWidth: list.orientation == ListView.Horizontal ? list.contentWidth : Theme.gridUnit * 10
+    implicitHeight: list.orientation == ListView.Horizontal ? Theme.gridUnit : list.contentHeight
+
+    contentItem: ListView {
+        id: list
+
+        clip: true
+        spacing: control.spacing
+        boundsBehavior: Flickable.StopAtBounds
+
+        model: Charts.LegendSortFilterModel {
+            id: sortFilterModel
+            sourceModel: Charts.LegendModel { chart: control.chart; sourceIndex: control.sourceIndex; formatter: control.formatter }
+        }
+
+        delegate: LegendDelegate {
+            width: list.orientation == ListView.Vertical ? list.width : implicitWidth
+            height: list.orientation == ListView.Vertical ? implicitHeight : list.height
+
+            name: model.name !== undefined ? model.name : ""
+            color: model.color !== undefined ? model.color : "white"
+            value: {
+                if (control.formatter) {
+                    return model.formattedValue
+                }
+                return model.value !== undefined ? control.formatValue(model.value) : ""
+            }
+
+            colorVisible: control.colorVisible
+            colorWidth: control.colorWidth
+            valueVisible: control.valueVisible
+            valueWidth: control.valueWidth
+
+            indicator: control.indicator
+
+            font: control.font
+
+            layoutWidth: list.orientation == ListView.Vertical ? list.width : -1
+        }
+    }
+}
@@ -83,4 +83,21 @@ RowLayout {
         editable: true
         onValueModified: range.increment = value
     }
+    CheckBox {
+        checked: range.niceBounds
+        text: "Nice Bounds"
+        enabled: automaticCheckbox.checked
+        onToggled: range.niceBounds = checked
+    }
+    Label {
+        text: "Hysteresis"
+    }
+    SpinBox {
+        from: 0
+        to: 100
+        value: range.hysteresis * 100
+        editable: true
+        enabled: automaticCheckbox.checked
+        onValueModified: range.hysteresis = value / 100
+    }
 }
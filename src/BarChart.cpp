@@ -31,7 +31,6 @@
 BarChart::BarChart(QQuickItem *parent)
     : XYChart(parent)
 {
-    connect(this, &BarChart::computedRangeChanged, this, &BarChart::onDataChanged);
 }
 
 qreal BarChart::spacing() const
@@ -46,7 +45,7 @@ void BarChart::setSpacing(qreal newSpacing)
     }
 
     m_spacing = newSpacing;
-    update();
+    invalidate(LayoutDirty);
     Q_EMIT spacingChanged();
 }
 
@@ -62,7 +61,7 @@ void BarChart::setBarWidth(qreal newBarWidth)
     }
 
     m_barWidth = newBarWidth;
-    update();
+    invalidate(LayoutDirty);
     Q_EMIT barWidthChanged();
 }
 
@@ -138,18 +137,20 @@ QSGNode *BarChart::updatePaintNode(QSGNode *node, QQuickItem::UpdatePaintNodeDat
     barNode->setValues(values);
     barNode->setBarWidth(w);
 
-    barNode->update();
+    barNode->commit();
 
     return barNode;
 }
 
 void BarChart::onDataChanged()
 {
-    m_values.clear();
+    const auto range = computedRange();
+    if (!inputChanged({range.startX, range.endX, range.startY, range.endY, int(indexingMode()), stacked(), int(direction())})) {
+        return;
+    }
 
-    updateComputedRange();
+    m_values.clear();
 
-    const auto range = computedRange();
     const auto sources = valueSources();
     auto colors = colorSource();
     auto indexMode = indexingMode();
@@ -20,12 +20,23 @@
  */
 
 #include "Chart.h"
+
+#include <iterator>
+
+#include <QDebug>
+#include <QQuickWindow>
+#include <QTimer>
+
 #include "datasource/ChartDataSource.h"
 
 Chart::Chart(QQuickItem *parent)
     : QQuickItem(parent)
 {
     setFlag(ItemHasContents, true);
+
+    m_updateTimer = new QTimer{this};
+    m_updateTimer->setSingleShot(true);
+    connect(m_updateTimer, &QTimer::timeout, this, &Chart::processDataChanged);
 }
 
 ChartDataSource *Chart::nameSource() const
@@ -76,9 +87,9 @@ void Chart::insertValueSource(int index, ChartDataSource *source)
 
     m_valueSources.insert(index, source);
     connect(source, &QObject::destroyed, this, qOverload<QObject *>(&Chart::removeValueSource));
-    connect(source, &ChartDataSource::dataChanged, this, &Chart::onDataChanged);
+    connect(source, &ChartDataSource::dataChanged, this, &Chart::queueDataChanged);
 
-    onDataChanged();
+    queueDataChanged();
     Q_EMIT valueSourcesChanged();
 }
 
@@ -91,7 +102,7 @@ void Chart::removeValueSource(int index)
     m_valueSources.at(index)->disconnect(this);
     m_valueSources.remove(index);
 
-    onDataChanged();
+    queueDataChanged();
     Q_EMIT valueSourcesChanged();
 }
 
@@ -112,23 +123,282 @@ void Chart::setIndexingMode(IndexingMode newIndexingMode)
     }
 
     m_indexingMode = newIndexingMode;
-    onDataChanged();
+    invalidate(DataDirty);
     Q_EMIT indexingModeChanged();
 }
 
+qreal Chart::maximumUpdateRate() const
+{
+    return m_maximumUpdateRate;
+}
+
+void Chart::setMaximumUpdateRate(qreal newMaximumUpdateRate)
+{
+    if (qFuzzyCompare(newMaximumUpdateRate, m_maximumUpdateRate)) {
+        return;
+    }
+
+    m_maximumUpdateRate = newMaximumUpdateRate;
+
+    // Reschedule any delayed update using the new rate.
+    if (m_updateTimer->isActive()) {
+        m_updateTimer->stop();
+        queueDataChanged();
+    }
+
+    Q_EMIT maximumUpdateRateChanged();
+}
+
+QVector<quint64> Chart::sourceRevisions() const
+{
+    QVector<quint64> result;
+    result.reserve(m_valueSources.size() + 2);
+
+    std::transform(m_valueSources.cbegin(), m_valueSources.cend(), std::back_inserter(result), [](ChartDataSource *source) {
+        return source->revision();
+    });
+    result << (m_nameSource ? m_nameSource->revision() : 0);
+    result << (m_colorSource ? m_colorSource->revision() : 0);
+
+    return result;
+}
+
+bool Chart::inputChanged(const QVariantList &state)
+{
+    auto revisions = sourceRevisions();
+    if (m_inputValid && revisions == m_inputRevisions && state == m_inputState) {
+        return false;
+    }
+
+    m_inputValid = true;
+    m_inputRevisions = revisions;
+    m_inputState = state;
+    return true;
+}
+
+void Chart::beginUpdate()
+{
+    m_updateDepth++;
+}
+
+void Chart::endUpdate()
+{
+    if (m_updateDepth <= 0) {
+        qWarning() << "Chart::endUpdate called without matching beginUpdate";
+        return;
+    }
+
+    m_updateDepth--;
+
+    if (m_updateDepth == 0 && m_dataChangedPending) {
+        m_dataChangedPending = false;
+        if (m_maximumUpdateRate > 0.0) {
+            queueDataChanged();
+        } else {
+            processDataChanged();
+        }
+    }
+}
+
+void Chart::queueDataChanged()
+{
+    // Until the component is complete, properties and sources are still being
+    // set up, so there is no point in processing anything yet.
+    if (!isComponentComplete()) {
+        return;
+    }
+
+    if (m_updateDepth > 0) {
+        m_dataChangedPending = true;
+        return;
+    }
+
+    if (m_dataChangedQueued || m_updateTimer->isActive()) {
+        return;
+    }
+
+    if (m_maximumUpdateRate > 0.0 && m_lastUpdate.isValid()) {
+        const auto remaining = qRound64(1000.0 / m_maximumUpdateRate) - m_lastUpdate.elapsed();
+        if (remaining > 0) {
+            m_updateTimer->start(int(remaining));
+            return;
+        }
+    }
+
+    m_dataChangedQueued = true;
+    QMetaObject::invokeMethod(this, &Chart::processDataChanged, Qt::QueuedConnection);
+}
+
+void Chart::processDataChanged()
+{
+    m_dataChangedQueued = false;
+
+    if (!isComponentComplete()) {
+        return;
+    }
+
+    if (m_updateDepth > 0) {
+        m_dataChangedPending = true;
+        return;
+    }
+
+    // Nothing of an invisible chart can be seen, so wait until it becomes
+    // visible again and then process all changes at once.
+    if (!isEffectivelyVisible()) {
+        m_dataChangedSuspended = true;
+        return;
+    }
+
+    m_lastUpdate.start();
+    invalidate(DataDirty);
+}
+
+void Chart::invalidate(DirtyFlags flags)
+{
+    m_dirtyFlags |= flags;
+
+    if (!(flags & ~DirtyFlags(StyleDirty))) {
+        update();
+        return;
+    }
+
+    // Keep anything that needs processing until the chart can be seen again,
+    // so setters on an invisible chart do not cause any work either.
+    if (!isEffectivelyVisible()) {
+        m_polishSuspended = true;
+        return;
+    }
+
+    polish();
+}
+
+void Chart::processChanges(DirtyFlags flags)
+{
+    if (flags & (DataDirty | RangeDirty)) {
+        onDataChanged();
+    }
+
+    update();
+}
+
+void Chart::updatePolish()
+{
+    // Anything invalidated before this point is processed once the component
+    // is complete.
+    if (!isComponentComplete()) {
+        return;
+    }
+
+    const auto flags = m_dirtyFlags;
+    m_dirtyFlags = NotDirty;
+
+    if (flags == NotDirty) {
+        return;
+    }
+
+    processChanges(flags);
+
+    if (flags & DataDirty) {
+        Q_EMIT dataUpdated();
+    }
+}
+
+bool Chart::isEffectivelyVisible() const
+{
+    // isVisible() already includes the visibility of all ancestors, opacity
+    // does not, so combine it with that of all ancestors.
+    if (!isVisible()) {
+        return false;
+    }
+
+    for (auto item = static_cast<const QQuickItem *>(this); item; item = item->parentItem()) {
+        if (qFuzzyIsNull(item->opacity())) {
+            return false;
+        }
+    }
+
+    auto quickWindow = window();
+    if (!quickWindow) {
+        return false;
+    }
+
+    auto visibility = quickWindow->visibility();
+    return visibility != QWindow::Hidden && visibility != QWindow::Minimized;
+}
+
+void Chart::resumeIfVisible()
+{
+    if ((!m_dataChangedSuspended && !m_polishSuspended) || !isEffectivelyVisible()) {
+        return;
+    }
+
+    if (m_polishSuspended) {
+        m_polishSuspended = false;
+        polish();
+    }
+
+    if (m_dataChangedSuspended) {
+        m_dataChangedSuspended = false;
+        queueDataChanged();
+    }
+}
+
+void Chart::updateAncestorConnections()
+{
+    // Only changes to the opacity of the chart itself are passed to
+    // itemChange(), so track those of its ancestors separately.
+    std::for_each(m_ancestorConnections.cbegin(), m_ancestorConnections.cend(), [](const QMetaObject::Connection &connection) {
+        disconnect(connection);
+    });
+    m_ancestorConnections.clear();
+
+    for (auto item = parentItem(); item; item = item->parentItem()) {
+        m_ancestorConnections << connect(item, &QQuickItem::opacityChanged, this, &Chart::resumeIfVisible);
+        m_ancestorConnections << connect(item, &QQuickItem::parentChanged, this, &Chart::updateAncestorConnections);
+    }
+}
+
+void Chart::itemChange(QQuickItem::ItemChange change, const QQuickItem::ItemChangeData &data)
+{
+    QQuickItem::itemChange(change, data);
+
+    switch (change) {
+    case ItemSceneChange:
+        disconnect(m_windowConnection);
+        if (data.window) {
+            m_windowConnection = connect(data.window, &QWindow::visibilityChanged, this, &Chart::resumeIfVisible);
+        }
+        resumeIfVisible();
+        break;
+    case ItemParentHasChanged:
+        updateAncestorConnections();
+        resumeIfVisible();
+        break;
+    case ItemVisibleHasChanged:
+    case ItemOpacityHasChanged:
+        resumeIfVisible();
+        break;
+    default:
+        break;
+    }
+}
 
 void Chart::componentComplete()
 {
     QQuickItem::componentComplete();
-    onDataChanged();
+
+    updateAncestorConnections();
+
+    // Everything before this point was skipped, so do a single full update.
+    processDataChanged();
 }
 
 void Chart::appendSource(Chart::DataSourcesProperty *list, ChartDataSource *source)
 {
     auto chart = reinterpret_cast<Chart *>(list->data);
     chart->m_valueSources.append(source);
-    QObject::connect(source, &ChartDataSource::dataChanged, chart, &Chart::onDataChanged);
-    chart->onDataChanged();
+    QObject::connect(source, &ChartDataSource::dataChanged, chart, &Chart::queueDataChanged);
+    chart->queueDataChanged();
 }
 
 int Chart::sourceCount(Chart::DataSourcesProperty *list)
@@ -146,5 +416,5 @@ void Chart::clearSources(Chart::DataSourcesProperty *list)
     auto chart = reinterpret_cast<Chart *>(list->data);
     std::for_each(chart->m_valueSources.cbegin(), chart->m_valueSources.cend(), [chart](ChartDataSource *source) { source->disconnect(chart); });
     chart->m_valueSources.clear();
-    chart->onDataChanged();
+    chart->queueDataChanged();
 }
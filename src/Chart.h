@@ -22,8 +22,10 @@
 #ifndef CHART_H
 #define CHART_H
 
+#include <QElapsedTimer>
 #include <QQuickItem>
 
+class QTimer;
 class ChartDataSource;
 
 /**
@@ -48,6 +50,14 @@ class Chart : public QQuickItem
      * The indexing mode used for indexing colors and names.
      */
     Q_PROPERTY(IndexingMode indexingMode READ indexingMode WRITE setIndexingMode NOTIFY indexingModeChanged)
+    /**
+     * The maximum amount of times per second changes to the data are processed.
+     *
+     * Changes arriving faster than this are accumulated and processed
+     * together. The last change is always processed. Zero, the default,
+     * means changes are processed once per event loop iteration.
+     */
+    Q_PROPERTY(qreal maximumUpdateRate READ maximumUpdateRate WRITE setMaximumUpdateRate NOTIFY maximumUpdateRateChanged)
 
 public:
     using DataSourcesProperty = QQmlListProperty<ChartDataSource>;
@@ -62,6 +72,18 @@ public:
     };
     Q_ENUM(IndexingMode)
 
+    /**
+     * The parts of a chart that need to be updated.
+     */
+    enum DirtyFlag {
+        NotDirty = 0,
+        DataDirty = 1 << 0, ///< The data of the sources changed.
+        RangeDirty = 1 << 1, ///< The range of values to display changed.
+        LayoutDirty = 1 << 2, ///< The size or layout of the chart changed.
+        StyleDirty = 1 << 3, ///< Only the appearance of the chart changed.
+    };
+    Q_DECLARE_FLAGS(DirtyFlags, DirtyFlag)
+
     explicit Chart(QQuickItem *parent = nullptr);
     ~Chart() override = default;
 
@@ -84,6 +106,41 @@ public:
     void setIndexingMode(IndexingMode newIndexingMode);
     Q_SIGNAL void indexingModeChanged();
 
+    qreal maximumUpdateRate() const;
+    void setMaximumUpdateRate(qreal newMaximumUpdateRate);
+    Q_SIGNAL void maximumUpdateRateChanged();
+
+    /**
+     * Emitted after changes to the data of this chart have been processed.
+     *
+     * This follows maximumUpdateRate, so anything depending on the data of
+     * this chart can use it to update at the same rate.
+     */
+    Q_SIGNAL void dataUpdated();
+
+    /**
+     * The revisions of all value, name and color sources of this chart.
+     *
+     * This changes whenever any of the sources changes or when sources are
+     * added, removed or replaced.
+     */
+    QVector<quint64> sourceRevisions() const;
+
+    /**
+     * Start a batch of changes.
+     *
+     * Until a matching call to endUpdate(), changes to the data of this chart
+     * are collected instead of processed. Calls can be nested.
+     */
+    Q_INVOKABLE void beginUpdate();
+    /**
+     * End a batch of changes started by beginUpdate().
+     *
+     * If any data changed during the batch, it is processed once when the
+     * outermost batch ends.
+     */
+    Q_INVOKABLE void endUpdate();
+
 protected:
     /**
      * Called when the data of a value source changes.
@@ -92,20 +149,90 @@ protected:
      * the data of one of the value sources changes. Subclasses should use this
      * to make sure that they update whatever internal state they use for
      * rendering, then call update() to schedule rendering the item.
+     *
+     * This is not called before the component is complete. Subclasses should
+     * use queueDataChanged() or invalidate() rather than calling this directly.
      */
     virtual void onDataChanged() = 0;
     void componentComplete() override;
 
+    /**
+     * Schedule processing a change to the data of this chart.
+     *
+     * All calls during a single event loop iteration, or during a batch
+     * started by beginUpdate(), result in a single call to onDataChanged().
+     * When maximumUpdateRate is set, the call is delayed if needed. Changes
+     * are not processed while the chart is not visible.
+     */
+    void queueDataChanged();
+
+    void itemChange(QQuickItem::ItemChange change, const QQuickItem::ItemChangeData &data) override;
+
+    /**
+     * Check whether anything the data of this chart depends on changed.
+     *
+     * This compares the revisions of all sources and \p state with those
+     * passed to the previous call. \p state should contain everything else
+     * the data depends on, such as ranges and settings.
+     *
+     * @return true if anything changed since the previous call.
+     */
+    bool inputChanged(const QVariantList &state);
+
+    /**
+     * Mark parts of this chart as needing an update.
+     *
+     * Changes are collected and processed at most once per frame, by
+     * processChanges(). A change that only affects StyleDirty never causes
+     * any data to be processed, it only schedules rendering the item. Other
+     * changes are kept while the chart is not visible and processed once it
+     * becomes visible again.
+     */
+    void invalidate(DirtyFlags flags);
+
+    /**
+     * Process all changes collected by invalidate() since the last call.
+     *
+     * The default implementation calls onDataChanged() if data or range
+     * changed and then schedules rendering the item. Subclasses can
+     * reimplement this to handle other changes.
+     */
+    virtual void processChanges(DirtyFlags flags);
+
+    void updatePolish() override;
+
 private:
     static void appendSource(DataSourcesProperty *list, ChartDataSource *source);
     static int sourceCount(DataSourcesProperty *list);
     static ChartDataSource *source(DataSourcesProperty *list, int index);
     static void clearSources(DataSourcesProperty *list);
 
+    void processDataChanged();
+    bool isEffectivelyVisible() const;
+    void resumeIfVisible();
+    void updateAncestorConnections();
+
     ChartDataSource *m_nameSource = nullptr;
     ChartDataSource *m_colorSource = nullptr;
     QVector<ChartDataSource *> m_valueSources;
     IndexingMode m_indexingMode = IndexEachSource;
+    qreal m_maximumUpdateRate = 0.0;
+    QTimer *m_updateTimer = nullptr;
+    QElapsedTimer m_lastUpdate;
+    bool m_dataChangedQueued = false;
+    bool m_dataChangedPending = false;
+    int m_updateDepth = 0;
+    // Set when changes were not processed because the chart was not visible.
+    bool m_dataChangedSuspended = false;
+    bool m_polishSuspended = false;
+    QMetaObject::Connection m_windowConnection;
+    QVector<QMetaObject::Connection> m_ancestorConnections;
+    bool m_inputValid = false;
+    QVector<quint64> m_inputRevisions;
+    QVariantList m_inputState;
+    DirtyFlags m_dirtyFlags = NotDirty;
 };
 
+Q_DECLARE_OPERATORS_FOR_FLAGS(Chart::DirtyFlags)
+
 #endif // CHART_H
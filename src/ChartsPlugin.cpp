@@ -26,11 +26,13 @@
 #include "LineChart.h"
 #include "PieChart.h"
 #include "RangeGroup.h"
+#include "ValueFormatter.h"
 #include "XYChart.h"
 
 #include "decorations/AxisLabels.h"
 #include "decorations/GridLines.h"
 #include "decorations/LegendModel.h"
+#include "decorations/LegendSortFilterModel.h"
 
 #include "datasource/ArraySource.h"
 #include "datasource/ChartAxisSource.h"
@@ -67,10 +69,12 @@ void QuickChartsPlugin::registerTypes(const char *uri)
     qmlRegisterType<ColorGradientSource>(uri, 1, 0, "ColorGradientSource");
 
     qmlRegisterUncreatableType<RangeGroup>(uri, 1, 0, "Range", QStringLiteral("Used as a grouped property"));
+    qmlRegisterType<ValueFormatter>(uri, 1, 0, "ValueFormatter");
 
     qmlRegisterType<GridLines>(uri, 1, 0, "GridLines");
     qmlRegisterUncreatableType<LinePropertiesGroup>(uri, 1, 0, "LinePropertiesGroup", QStringLiteral("Used as a grouped property"));
     qmlRegisterType<AxisLabels>(uri, 1, 0, "AxisLabels");
     qmlRegisterUncreatableType<AxisLabelsAttached>(uri, 1, 0, "AxisLabelsAttached", QStringLiteral("Attached property"));
     qmlRegisterType<LegendModel>(uri, 1, 0, "LegendModel");
+    qmlRegisterType<LegendSortFilterModel>(uri, 1, 0, "LegendSortFilterModel");
 }
@@ -21,19 +21,43 @@
 
 #include "LineChart.h"
 
-#include <QPainter>
-#include <QPainterPath>
 #include <numeric>
 
+#include "LineChartPreparation.h"
 #include "RangeGroup.h"
 #include "datasource/ChartDataSource.h"
 #include "scenegraph/LineChartNode.h"
 #include "scenegraph/LineGridNode.h"
 
-QVector<QVector2D> interpolate(const QVector<QVector2D> &points, qreal start, qreal end, qreal height);
+// The maximum time in milliseconds to wait for the preparation of the latest
+// data while rendering, about half a frame at 60 frames per second.
+static const int MaximumPreparationWait = 8;
+
+// Scale the X coordinates of prepared points from one rect to another, so
+// that an outdated result still fills the chart while a new one is prepared.
+static QVector<QVector<QVector2D>> rescale(const QVector<QVector<QVector2D>> &series, const QRectF &from, const QRectF &to)
+{
+    if (from.width() <= 0.0 || from == to) {
+        return series;
+    }
+
+    const auto scale = float(to.width() / from.width());
+    auto result = series;
+    for (auto &points : result) {
+        for (auto &point : points) {
+            point.setX(float(to.left()) + (point.x() - float(from.left())) * scale);
+        }
+    }
+    return result;
+}
 
 LineChart::LineChart(QQuickItem *parent)
     : XYChart(parent)
+{
+    m_preparation = std::make_unique<LineChartPreparation>(this);
+}
+
+LineChart::~LineChart()
 {
 }
 
@@ -59,7 +83,7 @@ void LineChart::setSmooth(bool smooth)
     }
 
     m_smooth = smooth;
-    update();
+    invalidate(LayoutDirty);
     Q_EMIT smoothChanged();
 }
 
@@ -70,7 +94,7 @@ void LineChart::setLineWidth(qreal width)
     }
 
     m_lineWidth = width;
-    update();
+    invalidate(StyleDirty);
     Q_EMIT lineWidthChanged();
 }
 
@@ -81,133 +105,106 @@ void LineChart::setFillOpacity(qreal opacity)
     }
 
     m_fillOpacity = opacity;
-    update();
+    invalidate(StyleDirty);
     Q_EMIT fillOpacityChanged();
 }
 
-QSGNode *LineChart::updatePaintNode(QSGNode *node, QQuickItem::UpdatePaintNodeData *data)
+void LineChart::processChanges(DirtyFlags flags)
 {
-    Q_UNUSED(data);
+    XYChart::processChanges(flags);
 
-    if (!node) {
-        node = new QSGNode();
+    // The positions of points depend on the size of the chart, so they need
+    // to be prepared again when the layout changes.
+    if (flags & LayoutDirty) {
+        prepare();
     }
+}
 
-    if (m_rangeInvalid) {
-        updateComputedRange();
-        m_rangeInvalid = false;
-    }
+void LineChart::prepare()
+{
+    const auto range = computedRange();
+    const auto rect = boundingRect();
 
-    if (stacked()) {
-        m_previousValues.clear();
+    if (!inputChanged({range.startX, range.endX, range.startY, range.endY, rect, m_smooth, stacked(), int(direction())})) {
+        return;
     }
 
+    LineChartSnapshot snapshot;
+    snapshot.rect = rect;
+    snapshot.smooth = m_smooth;
+    snapshot.stacked = stacked();
+    snapshot.zeroAtStart = direction() == Direction::ZeroAtStart;
+    snapshot.startX = range.startX;
+    snapshot.startY = range.startY;
+    snapshot.distanceY = range.distanceY;
+
+    // Sources can only be accessed from the GUI thread, so copy their values
+    // here and leave everything else to the preparation.
     const auto sources = valueSources();
-    for (int i = 0; i < sources.size(); ++i) {
-        int childIndex = sources.size() - 1 - i;
-        while (childIndex >= node->childCount()) {
-            node->appendChildNode(new LineChartNode{});
+    snapshot.values.reserve(sources.size());
+    for (auto source : sources) {
+        QVector<float> values(range.distanceX);
+        for (int i = 0; i < range.distanceX; ++i) {
+            values[i] = source->item(range.startX + i).toFloat();
         }
-        auto lineNode = static_cast<LineChartNode *>(node->childAtIndex(childIndex));
-        auto color = colorSource() ? colorSource()->item(i).value<QColor>() : Qt::black;
-        updateLineNode(lineNode, color, sources.at(i));
-    }
-
-    while (node->childCount() > sources.size()) {
-        node->removeChildNode(node->childAtIndex(node->childCount() - 1));
+        snapshot.values << values;
     }
 
-    return node;
+    m_preparation->prepare(snapshot);
 }
 
-void LineChart::onDataChanged()
+QSGNode *LineChart::updatePaintNode(QSGNode *node, QQuickItem::UpdatePaintNodeData *data)
 {
-    m_rangeInvalid = true;
-    update();
-}
+    Q_UNUSED(data);
 
-void LineChart::updateLineNode(LineChartNode *node, const QColor &lineColor, ChartDataSource *valueSource)
-{
-    auto fillColor = lineColor;
-    fillColor.setRedF(fillColor.redF() * m_fillOpacity);
-    fillColor.setGreenF(fillColor.greenF() * m_fillOpacity);
-    fillColor.setBlueF(fillColor.blueF() * m_fillOpacity);
-    fillColor.setAlphaF(m_fillOpacity);
-
-    node->setRect(boundingRect());
-    node->setLineColor(lineColor);
-    node->setFillColor(fillColor);
-    node->setLineWidth(m_lineWidth);
-
-    auto range = computedRange();
-
-    float stepSize = width() / (range.distanceX - 1);
-    QVector<QVector2D> values(range.distanceX);
-    auto generator = [&, i = range.startX]() mutable -> QVector2D {
-        auto result = QVector2D{direction() == Direction::ZeroAtStart ? i * stepSize : float(boundingRect().right()) - i * stepSize,
-                                (valueSource->item(i).toFloat() - range.startY) / range.distanceY};
-        i++;
-        return result;
-    };
-
-    if (direction() == Direction::ZeroAtStart) {
-        std::generate_n(values.begin(), range.distanceX, generator);
-    } else {
-        std::generate_n(values.rbegin(), range.distanceX, generator);
+    bool newNode = false;
+    if (!node) {
+        node = new LineChartNode{};
+        newNode = true;
     }
 
-    if (stacked() && !m_previousValues.isEmpty()) {
-        if (values.size() != m_previousValues.size()) {
-            qWarning() << "Value source" << valueSource->objectName()
-                       << "has a different number of elements from the previuous source. Ignoring stacking for this source.";
-        } else {
-            std::for_each(
-                values.begin(), values.end(), [this, i = 0](QVector2D &point) mutable { point.setY(point.y() + m_previousValues.at(i++).y()); });
-        }
-    }
-    m_previousValues = values;
+    const bool hasResult = m_preparation->takeResult(m_prepared, MaximumPreparationWait);
+    const auto rect = boundingRect();
 
-    if (m_smooth) {
-        values = interpolate(values, 0.0, width(), height());
+    QVector<QColor> lineColors;
+    lineColors.reserve(m_prepared.series.size());
+    for (int i = 0; i < m_prepared.series.size(); ++i) {
+        lineColors << (colorSource() ? colorSource()->item(i).value<QColor>() : QColor{Qt::black});
     }
 
-    node->setValues(values);
-}
-
-QVector<QVector2D> interpolate(const QVector<QVector2D> &points, qreal start, qreal end, qreal height)
-{
-    QPainterPath path;
-    if (points.size() < 4)
-        return points;
-
-    const QMatrix4x4 matrix(0, 1, 0, 0, -1 / 6., 1, 1 / 6., 0, 0, 1 / 6., 1, -1 / 6., 0, 0, 1, 0);
-
-    const qreal xDelta = (end - start) / (points.count() - 3);
-    qreal x = start - xDelta;
+    auto lineNode = static_cast<LineChartNode *>(node);
 
-    path.moveTo(start, points[0].y() * height);
+    lineNode->setRect(rect);
+    lineNode->setLineWidth(m_lineWidth);
+    lineNode->setSeriesCount(m_prepared.series.size());
 
-    for (int i = 1; i < points.count() - 2; i++) {
-        const QMatrix4x4 p(x,              points[i - 1].y() * height, 0, 0,
-                           x + xDelta * 1, points[i + 0].y() * height, 0, 0,
-                           x + xDelta * 2, points[i + 1].y() * height, 0, 0,
-                           x + xDelta * 3, points[i + 2].y() * height, 0, 0);
-
-        const QMatrix4x4 res = matrix * p;
+    if (newNode || hasResult || rect != m_nodeRect || lineColors != m_nodeLineColors || m_fillOpacity != m_nodeFillOpacity) {
+        const auto series = rescale(m_prepared.series, m_prepared.rect, rect);
+        for (int i = 0; i < series.size(); ++i) {
+            auto fillColor = lineColors.at(i);
+            fillColor.setAlphaF(m_fillOpacity);
+            lineNode->setSeries(i, series.at(i), lineColors.at(i), fillColor);
+        }
+        m_nodeRect = rect;
+        m_nodeLineColors = lineColors;
+        m_nodeFillOpacity = m_fillOpacity;
+    }
 
-        path.cubicTo(res(1, 0), res(1, 1), res(2, 0), res(2, 1), res(3, 0), res(3, 1));
+    lineNode->commit();
 
-        x += xDelta;
-    }
+    return lineNode;
+}
 
-    QVector<QVector2D> result;
+void LineChart::geometryChanged(const QRectF &newGeometry, const QRectF &oldGeometry)
+{
+    XYChart::geometryChanged(newGeometry, oldGeometry);
 
-    const auto polygons = path.toSubpathPolygons();
-    for (const auto &polygon : polygons) {
-        for (auto point : polygon) {
-            result.append(QVector2D{float(point.x()), float(point.y() / height)});
-        }
+    if (newGeometry.size() != oldGeometry.size()) {
+        invalidate(LayoutDirty);
     }
+}
 
-    return result;
+void LineChart::onDataChanged()
+{
+    prepare();
 }
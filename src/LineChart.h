@@ -24,9 +24,11 @@
 
 #include <memory>
 
-#include "XYChart.h"
+#include <QColor>
+#include <QVector>
 
-class LineChartNode;
+#include "LineChartPreparation.h"
+#include "XYChart.h"
 
 /**
  * A line chart.
@@ -50,6 +52,7 @@ class LineChart : public XYChart
 
 public:
     explicit LineChart(QQuickItem *parent = nullptr);
+    ~LineChart() override;
 
     bool smooth() const;
     void setSmooth(bool smooth);
@@ -64,17 +67,24 @@ public:
     Q_SIGNAL void fillOpacityChanged();
 
 protected:
+    void processChanges(DirtyFlags flags) override;
     QSGNode *updatePaintNode(QSGNode *node, QQuickItem::UpdatePaintNodeData *data) override;
+    void geometryChanged(const QRectF &newGeometry, const QRectF &oldGeometry) override;
     void onDataChanged() override;
 
 private:
-    void updateLineNode(LineChartNode *node, const QColor &lineColor, ChartDataSource *valueSource);
+    void prepare();
 
     bool m_smooth = false;
     qreal m_lineWidth = 1.0;
     qreal m_fillOpacity = 0.0;
-    bool m_rangeInvalid = true;
-    QVector<QVector2D> m_previousValues;
+    std::unique_ptr<LineChartPreparation> m_preparation;
+    // Only accessed while the GUI thread is blocked for rendering.
+    LineChartPrepared m_prepared;
+    // State last pushed to the node, used to skip redundant series updates.
+    QRectF m_nodeRect;
+    QVector<QColor> m_nodeLineColors;
+    qreal m_nodeFillOpacity = -1.0;
 };
 
 #endif // LINECHART_H
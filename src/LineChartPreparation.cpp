@@ -0,0 +1,386 @@
+/*
+ * This file is part of Quick Charts.
+ * Copyright 2019 Arjen Hiemstra <ahiemstra@heimr.nl>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License or (at your option) version 3 or any later version
+ * accepted by the membership of KDE e.V. (or its successor approved
+ * by the membership of KDE e.V.), which shall act as a proxy
+ * defined in Section 14 of version 3 of the license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "LineChartPreparation.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QMutex>
+#include <QObject>
+#include <QRunnable>
+#include <QThreadPool>
+#include <QWaitCondition>
+#include <QtMath>
+
+// The maximum amount of points per pixel column. Any more points than this
+// cannot be distinguished on screen, so they are reduced before rendering.
+static const int MaxPointsPerPixel = 2;
+// The maximum distance in pixels between a smoothed line and its straight
+// approximation.
+static const float SmoothTolerance = 0.25;
+// The minimum length in pixels of a straight part of a smoothed line.
+static const float MinSmoothStep = 2.0;
+
+namespace
+{
+// Reduce points to at most MaxPointsPerPixel per pixel column, keeping the
+// minimum and maximum of each column so peaks remain visible.
+QVector<QVector2D> decimate(const QVector<QVector2D> &values, const QRectF &rect)
+{
+    if (values.size() <= rect.width() * MaxPointsPerPixel) {
+        return values;
+    }
+
+    QVector<QVector2D> result;
+    result.reserve(int(std::ceil(rect.width())) * MaxPointsPerPixel + MaxPointsPerPixel);
+
+    int index = 0;
+    while (index < values.size()) {
+        const auto column = int(values.at(index).x() - rect.left());
+        auto minIndex = index;
+        auto maxIndex = index;
+
+        index++;
+        while (index < values.size() && int(values.at(index).x() - rect.left()) == column) {
+            if (values.at(index).y() < values.at(minIndex).y()) {
+                minIndex = index;
+            }
+            if (values.at(index).y() > values.at(maxIndex).y()) {
+                maxIndex = index;
+            }
+            index++;
+        }
+
+        if (minIndex == maxIndex) {
+            result << values.at(minIndex);
+        } else {
+            result << values.at(std::min(minIndex, maxIndex)) << values.at(std::max(minIndex, maxIndex));
+        }
+    }
+
+    return result;
+}
+
+/**
+ * Identifies a span of a smoothed line by the positions of its control points
+ * relative to the start of the span.
+ *
+ * Positions are quantized, so spans that only moved by some amount of pixels
+ * still match despite rounding differences.
+ */
+struct SmoothSpanKey {
+    SmoothSpanKey(const QVector2D &before, const QVector2D &start, const QVector2D &end, const QVector2D &after);
+
+    QVector2D point(int index) const;
+
+    bool operator==(const SmoothSpanKey &other) const
+    {
+        return std::equal(coordinates, coordinates + 6, other.coordinates);
+    }
+
+    qint32 coordinates[6];
+};
+
+uint qHash(const SmoothSpanKey &key, uint seed = 0)
+{
+    return qHashRange(key.coordinates, key.coordinates + 6, seed);
+}
+
+struct SmoothSpan {
+    // Points inside the span, relative to its start.
+    QVector<QVector2D> points;
+    // The last update that used this span.
+    quint32 generation = 0;
+};
+
+// Tessellated spans of a single series, kept between updates.
+struct SmoothCache {
+    QHash<SmoothSpanKey, SmoothSpan> spans;
+    quint32 generation = 0;
+};
+
+// The amount of steps per pixel used for quantizing the control points of a
+// smoothed span.
+static const float SpanQuantization = 64.0;
+
+SmoothSpanKey::SmoothSpanKey(const QVector2D &before, const QVector2D &start, const QVector2D &end, const QVector2D &after)
+{
+    auto quantize = [start](const QVector2D &point, qint32 *output) {
+        output[0] = qRound((point.x() - start.x()) * SpanQuantization);
+        output[1] = qRound((point.y() - start.y()) * SpanQuantization);
+    };
+
+    quantize(before, coordinates);
+    quantize(end, coordinates + 2);
+    quantize(after, coordinates + 4);
+}
+
+QVector2D SmoothSpanKey::point(int index) const
+{
+    return QVector2D(coordinates[index * 2], coordinates[index * 2 + 1]) / SpanQuantization;
+}
+
+// Tessellate a Catmull-Rom spline span, returning the points inside the span
+// relative to its start. The span is subdivided based on how far it deviates
+// from a straight line on screen, so straight spans do not produce any points.
+QVector<QVector2D> tessellate(const SmoothSpanKey &key)
+{
+    const auto p0 = key.point(0);
+    const auto p2 = key.point(1);
+    const auto p3 = key.point(2);
+
+    // Bezier control points of the span from the origin to p2.
+    const auto c1 = (p2 - p0) / 6.0f;
+    const auto c2 = p2 - p3 / 6.0f;
+
+    const auto direction = p2.normalized();
+    const auto flatness = std::max(c1.distanceToLine(QVector2D{}, direction), c2.distanceToLine(QVector2D{}, direction));
+
+    const auto maximumSteps = std::max(1, qCeil(p2.length() / MinSmoothStep));
+    const auto steps = qBound(1, qCeil(std::sqrt(0.75f * flatness / SmoothTolerance)), maximumSteps);
+
+    QVector<QVector2D> result;
+    result.reserve(steps - 1);
+    for (int step = 1; step < steps; ++step) {
+        const auto t = float(step) / steps;
+        const auto u = 1.0f - t;
+        result << c1 * (3.0f * u * u * t) + c2 * (3.0f * u * t * t) + p2 * (t * t * t);
+    }
+    return result;
+}
+
+// Tessellate a Catmull-Rom spline through values. Spans only depend on their
+// four control points, so spans that did not change relative to their start,
+// for example because the line scrolled, reuse their previous tessellation.
+// This only avoids tessellating again: the output is still rebuilt and every
+// span is still looked up, so each update remains linear in the point count.
+QVector<QVector2D> smooth(const QVector<QVector2D> &values, const QRectF &rect, SmoothCache &cache)
+{
+    if (values.size() < 3 || rect.height() <= 0.0) {
+        return values;
+    }
+
+    // Values are in pixels horizontally but normalized vertically.
+    const QVector2D scale{1.0f, float(rect.height())};
+    const auto last = values.size() - 1;
+
+    cache.generation++;
+
+    QVector<QVector2D> result;
+    result.reserve(values.size() * 2);
+    result << values.first();
+
+    for (int i = 0; i < last; ++i) {
+        const auto start = values.at(i) * scale;
+        const auto key = SmoothSpanKey{values.at(std::max(0, i - 1)) * scale, start, values.at(i + 1) * scale, values.at(std::min(last, i + 2)) * scale};
+
+        auto span = cache.spans.find(key);
+        if (span == cache.spans.end()) {
+            span = cache.spans.insert(key, SmoothSpan{tessellate(key), 0});
+        }
+        span->generation = cache.generation;
+
+        for (const auto &point : qAsConst(span->points)) {
+            result << (start + point) / scale;
+        }
+        result << values.at(i + 1);
+    }
+
+    // Drop spans that are no longer used once they make up most of the cache.
+    if (cache.spans.size() > last * 2) {
+        for (auto itr = cache.spans.begin(); itr != cache.spans.end();) {
+            if (itr->generation != cache.generation) {
+                itr = cache.spans.erase(itr);
+            } else {
+                ++itr;
+            }
+        }
+    }
+
+    return result;
+}
+
+LineChartPrepared process(const LineChartSnapshot &snapshot, QVector<SmoothCache> &caches)
+{
+    LineChartPrepared result;
+    result.rect = snapshot.rect;
+    result.series.reserve(snapshot.values.size());
+
+    caches.resize(snapshot.values.size());
+
+    QVector<float> previous;
+
+    for (int i = 0; i < snapshot.values.size(); ++i) {
+        const auto &values = snapshot.values.at(i);
+        const auto count = values.size();
+        const auto stepSize = count > 1 ? float(snapshot.rect.width()) / (count - 1) : 0.0f;
+
+        auto stack = snapshot.stacked && !previous.isEmpty();
+        if (stack && previous.size() != count) {
+            qWarning() << "Value source" << i << "has a different number of elements from the previuous source. Ignoring stacking for this source.";
+            stack = false;
+        }
+
+        QVector<float> current(count);
+        QVector<QVector2D> points(count);
+        for (int j = 0; j < count; ++j) {
+            auto y = (values.at(j) - snapshot.startY) / snapshot.distanceY;
+            if (stack) {
+                y += previous.at(j);
+            }
+            current[j] = y;
+
+            auto x = (snapshot.startX + j) * stepSize;
+            if (snapshot.zeroAtStart) {
+                points[j] = QVector2D{x, y};
+            } else {
+                points[count - 1 - j] = QVector2D{float(snapshot.rect.right()) - x, y};
+            }
+        }
+        previous = current;
+
+        points = decimate(points, snapshot.rect);
+        if (snapshot.smooth) {
+            points = smooth(points, snapshot.rect, caches[i]);
+        }
+
+        result.series << points;
+    }
+
+    return result;
+}
+
+} // namespace
+
+struct LineChartPreparation::State {
+    QMutex mutex;
+    // Cleared when the preparation is destroyed, while jobs may still run.
+    QObject *receiver = nullptr;
+    bool running = false;
+    // Signalled whenever a result is finished.
+    QWaitCondition finished;
+
+    bool hasSnapshot = false;
+    LineChartSnapshot snapshot;
+    // Incremented for every submitted snapshot, so results can be matched to them.
+    quint64 snapshotGeneration = 0;
+
+    bool hasResult = false;
+    LineChartPrepared result;
+    quint64 resultGeneration = 0;
+
+    // Only used by the running job.
+    QVector<SmoothCache> caches;
+};
+
+class PreparationJob : public QRunnable
+{
+public:
+    PreparationJob(const std::shared_ptr<LineChartPreparation::State> &state)
+        : m_state(state)
+    {
+    }
+
+    void run() override
+    {
+        QMutexLocker locker(&m_state->mutex);
+
+        while (m_state->hasSnapshot) {
+            auto snapshot = m_state->snapshot;
+            auto generation = m_state->snapshotGeneration;
+            m_state->snapshot = LineChartSnapshot{};
+            m_state->hasSnapshot = false;
+
+            locker.unlock();
+            auto result = process(snapshot, m_state->caches);
+            locker.relock();
+
+            m_state->result = result;
+            m_state->hasResult = true;
+            m_state->resultGeneration = generation;
+            m_state->finished.wakeAll();
+
+            if (m_state->receiver) {
+                QMetaObject::invokeMethod(m_state->receiver, "update", Qt::QueuedConnection);
+            }
+        }
+
+        m_state->running = false;
+    }
+
+private:
+    std::shared_ptr<LineChartPreparation::State> m_state;
+};
+
+LineChartPreparation::LineChartPreparation(QObject *receiver)
+    : m_state(std::make_shared<State>())
+{
+    m_state->receiver = receiver;
+}
+
+LineChartPreparation::~LineChartPreparation()
+{
+    QMutexLocker locker(&m_state->mutex);
+    m_state->receiver = nullptr;
+}
+
+void LineChartPreparation::prepare(const LineChartSnapshot &snapshot)
+{
+    QMutexLocker locker(&m_state->mutex);
+
+    m_state->snapshot = snapshot;
+    m_state->hasSnapshot = true;
+    m_state->snapshotGeneration++;
+
+    if (!m_state->running) {
+        m_state->running = true;
+        QThreadPool::globalInstance()->start(new PreparationJob{m_state});
+    }
+}
+
+bool LineChartPreparation::takeResult(LineChartPrepared &result, int timeout)
+{
+    QMutexLocker locker(&m_state->mutex);
+
+    // Wait for the last submitted snapshot, so the result is not older than
+    // the data, unless that takes too long.
+    QElapsedTimer timer;
+    timer.start();
+    while (m_state->resultGeneration < m_state->snapshotGeneration && m_state->running) {
+        const auto remaining = timeout - timer.elapsed();
+        if (remaining <= 0 || !m_state->finished.wait(&m_state->mutex, remaining)) {
+            break;
+        }
+    }
+
+    if (!m_state->hasResult) {
+        return false;
+    }
+
+    result = m_state->result;
+    m_state->result = LineChartPrepared{};
+    m_state->hasResult = false;
+    return true;
+}
@@ -0,0 +1,99 @@
+/*
+ * This file is part of Quick Charts.
+ * Copyright 2019 Arjen Hiemstra <ahiemstra@heimr.nl>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License or (at your option) version 3 or any later version
+ * accepted by the membership of KDE e.V. (or its successor approved
+ * by the membership of KDE e.V.), which shall act as a proxy
+ * defined in Section 14 of version 3 of the license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LINECHARTPREPARATION_H
+#define LINECHARTPREPARATION_H
+
+#include <memory>
+
+#include <QRectF>
+#include <QVector>
+#include <QVector2D>
+
+class QObject;
+class PreparationJob;
+
+/**
+ * A copy of everything needed to prepare the lines of a line chart.
+ *
+ * This is created on the GUI thread, so the preparation itself does not need
+ * to access the chart or its sources.
+ */
+struct LineChartSnapshot {
+    QRectF rect;
+    bool smooth = false;
+    bool stacked = false;
+    bool zeroAtStart = true;
+    int startX = 0;
+    float startY = 0.0;
+    float distanceY = 1.0;
+    // The values of each value source, starting at startX.
+    QVector<QVector<float>> values;
+};
+
+/**
+ * The render-ready points of each series of a line chart.
+ */
+struct LineChartPrepared {
+    QRectF rect;
+    QVector<QVector<QVector2D>> series;
+};
+
+/**
+ * Prepares the lines of a line chart on a worker thread.
+ *
+ * This normalizes, stacks, decimates and smooths the values of a snapshot
+ * using the global thread pool. Only one snapshot is processed at a time; if
+ * several snapshots are submitted while processing, only the last one is
+ * processed afterwards. Whenever a result is ready, the receiver's update()
+ * slot is invoked so the result can be picked up with takeResult().
+ */
+class LineChartPreparation
+{
+public:
+    explicit LineChartPreparation(QObject *receiver);
+    ~LineChartPreparation();
+
+    /**
+     * Schedule preparing a snapshot.
+     *
+     * Should be called from the GUI thread.
+     */
+    void prepare(const LineChartSnapshot &snapshot);
+
+    /**
+     * Retrieve the most recently finished result.
+     *
+     * If the last submitted snapshot is still being processed, this waits at
+     * most \p timeout milliseconds for it to finish.
+     *
+     * @return true if a new result was stored in \p result, false if nothing
+     *         new was finished since the last call.
+     */
+    bool takeResult(LineChartPrepared &result, int timeout = 0);
+
+private:
+    friend class PreparationJob;
+    struct State;
+    std::shared_ptr<State> m_state;
+};
+
+#endif // LINECHARTPREPARATION_H
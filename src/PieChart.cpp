@@ -21,19 +21,62 @@
 
 #include "PieChart.h"
 
+#include <numeric>
+
 #include <QAbstractItemModel>
 #include <QDebug>
+#include <QHash>
 
 #include "RangeGroup.h"
 #include "datasource/ChartDataSource.h"
 #include "scenegraph/PieChartNode.h"
 
+// Determine which items of a source are displayed as slices, combining the
+// smallest items into an "other" slice if there are more than maximumSlices.
+static qreal aggregateSlices(ChartDataSource *source, int maximumSlices, QVector<qreal> &values, QVector<int> &slices, qreal &otherValue)
+{
+    const auto count = source->itemCount();
+
+    values.resize(count);
+    for (int i = 0; i < count; ++i) {
+        values[i] = source->item(i).toReal();
+    }
+
+    const auto total = std::accumulate(values.cbegin(), values.cend(), 0.0);
+
+    slices.resize(count);
+    std::iota(slices.begin(), slices.end(), 0);
+    otherValue = 0.0;
+
+    if (maximumSlices <= 0 || count <= maximumSlices) {
+        return total;
+    }
+
+    // Move the largest items to the front, then restore their original order
+    // so slices and colors stay stable when only the item values change.
+    std::nth_element(slices.begin(), slices.begin() + maximumSlices, slices.end(), [&values](int first, int second) {
+        return values.at(first) > values.at(second);
+    });
+    std::sort(slices.begin(), slices.begin() + maximumSlices);
+
+    otherValue = std::accumulate(slices.cbegin() + maximumSlices, slices.cend(), 0.0, [&values](qreal current, int index) {
+        return current + values.at(index);
+    });
+
+    slices.resize(maximumSlices);
+    slices.append(-1);
+
+    return total;
+}
+
 PieChart::PieChart(QQuickItem *parent)
     : Chart(parent)
 {
-    setIndexingMode(Chart::IndexSourceValues);
     m_range = std::make_unique<RangeGroup>();
-    connect(m_range.get(), &RangeGroup::rangeChanged, this, &PieChart::onDataChanged);
+    setIndexingMode(Chart::IndexSourceValues);
+    connect(m_range.get(), &RangeGroup::rangeChanged, this, [this]() {
+        invalidate(RangeDirty);
+    });
 }
 
 RangeGroup *PieChart::range() const
@@ -53,7 +96,7 @@ void PieChart::setFilled(bool newFilled)
     }
 
     m_filled = newFilled;
-    update();
+    invalidate(StyleDirty);
     Q_EMIT filledChanged();
 }
 
@@ -69,7 +112,7 @@ void PieChart::setThickness(qreal newThickness)
     }
 
     m_thickness = newThickness;
-    update();
+    invalidate(StyleDirty);
     Q_EMIT thicknessChanged();
 }
 
@@ -85,7 +128,7 @@ void PieChart::setSpacing(qreal newSpacing)
     }
 
     m_spacing = newSpacing;
-    update();
+    invalidate(StyleDirty);
     Q_EMIT spacingChanged();
 }
 
@@ -100,7 +143,7 @@ void PieChart::setBackgroundColor(const QColor &color)
         return;
     }
     m_backgroundColor = color;
-    update();
+    invalidate(StyleDirty);
     Q_EMIT backgroundColorChanged();
 }
 
@@ -116,7 +159,7 @@ void PieChart::setFromAngle(qreal newFromAngle)
     }
 
     m_fromAngle = newFromAngle;
-    update();
+    invalidate(StyleDirty);
     Q_EMIT fromAngleChanged();
 }
 
@@ -132,7 +175,7 @@ void PieChart::setToAngle(qreal newToAngle)
     }
 
     m_toAngle = newToAngle;
-    update();
+    invalidate(StyleDirty);
     Q_EMIT toAngleChanged();
 }
 
@@ -148,15 +191,72 @@ void PieChart::setSmoothEnds(bool newSmoothEnds)
     }
 
     m_smoothEnds = newSmoothEnds;
-    update();
+    invalidate(StyleDirty);
     Q_EMIT smoothEndsChanged();
 }
 
+int PieChart::maximumSlices() const
+{
+    return m_maximumSlices;
+}
+
+void PieChart::setMaximumSlices(int newMaximumSlices)
+{
+    if (newMaximumSlices == m_maximumSlices) {
+        return;
+    }
+
+    m_maximumSlices = newMaximumSlices;
+    invalidate(DataDirty);
+    Q_EMIT maximumSlicesChanged();
+}
+
+QString PieChart::otherName() const
+{
+    return m_otherName;
+}
+
+void PieChart::setOtherName(const QString &newOtherName)
+{
+    if (newOtherName == m_otherName) {
+        return;
+    }
+
+    m_otherName = newOtherName;
+    Q_EMIT otherNameChanged();
+}
+
+QColor PieChart::otherColor() const
+{
+    return m_otherColor;
+}
+
+void PieChart::setOtherColor(const QColor &newOtherColor)
+{
+    if (newOtherColor == m_otherColor) {
+        return;
+    }
+
+    m_otherColor = newOtherColor;
+    invalidate(DataDirty);
+    Q_EMIT otherColorChanged();
+}
+
+QVector<int> PieChart::sliceIndices(int sourceIndex) const
+{
+    return m_slices.value(sourceIndex);
+}
+
+qreal PieChart::otherValue(int sourceIndex) const
+{
+    return m_otherValues.value(sourceIndex);
+}
+
 QSGNode *PieChart::updatePaintNode(QSGNode *node, UpdatePaintNodeData *data)
 {
     Q_UNUSED(data);
     if (!node) {
-        node = new QSGNode{};
+        node = new PieChartNode{};
     }
 
     auto sourceCount = valueSources().size();
@@ -167,37 +267,46 @@ QSGNode *PieChart::updatePaintNode(QSGNode *node, UpdatePaintNodeData *data)
 
     auto minDimension = std::min(width(), height());
 
+    auto pieNode = static_cast<PieChartNode *>(node);
+    pieNode->setRect(boundingRect());
+    pieNode->setRingCount(sourceCount);
+    pieNode->setBackgroundColor(m_backgroundColor);
+    pieNode->setFromAngle(m_fromAngle);
+    pieNode->setToAngle(m_toAngle);
+    pieNode->setSmoothEnds(m_smoothEnds);
+
     float outerRadius = minDimension;
     for (int i = 0; i < sourceCount; ++i) {
         float innerRadius = i == sourceCount - 1 && m_filled ? 0.0 : outerRadius - m_thickness;
 
-        if (node->childCount() <= i) {
-            node->appendChildNode(new PieChartNode{});
-        }
-
-        auto pieNode = static_cast<PieChartNode *>(node->childAtIndex(i));
-        pieNode->setRect(boundingRect());
-        pieNode->setInnerRadius(innerRadius);
-        pieNode->setOuterRadius(outerRadius);
-        pieNode->setSections(m_sections.at(i));
-        pieNode->setBackgroundColor(m_backgroundColor);
-        pieNode->setColors(m_colors.at(i));
-        pieNode->setFromAngle(m_fromAngle);
-        pieNode->setToAngle(m_toAngle);
-        pieNode->setSmoothEnds(m_smoothEnds);
+        pieNode->setInnerRadius(i, innerRadius);
+        pieNode->setOuterRadius(i, outerRadius);
+        pieNode->setSections(i, m_sections.at(i));
+        pieNode->setColors(i, m_colors.at(i));
 
         outerRadius = outerRadius - m_thickness - m_spacing;
     }
 
-    while (node->childCount() > sourceCount) {
-        node->removeChildNode(node->childAtIndex(node->childCount() - 1));
-    }
+    pieNode->commit();
 
     return node;
 }
 
 void PieChart::onDataChanged()
 {
+    if (!inputChanged({int(indexingMode()),
+                       m_maximumSlices,
+                       m_otherColor,
+                       m_range->from(),
+                       m_range->to(),
+                       m_range->automatic(),
+                       m_range->minimum(),
+                       m_range->increment(),
+                       m_range->niceBounds(),
+                       m_range->hysteresis()})) {
+        return;
+    }
+
     m_sections.clear();
     m_colors.clear();
 
@@ -205,32 +314,48 @@ void PieChart::onDataChanged()
     const auto colors = colorSource();
 
     if (!colors || sources.isEmpty() || !m_range->isValid()) {
+        updateSlices({}, {});
         return;
     }
 
-    auto maximum = [](ChartDataSource* source) {
-        qreal result = 0.0;
-        for (int i = 0; i < source->itemCount(); ++i) {
-            result += source->item(i).toDouble();
-        }
-        return result;
-    };
+    QVector<QVector<qreal>> values;
+    QVector<QVector<int>> slices;
+    QVector<qreal> otherValues;
+    QHash<ChartDataSource *, qreal> totals;
+
+    values.reserve(sources.size());
+    slices.reserve(sources.size());
+    otherValues.reserve(sources.size());
+
+    for (auto source : sources) {
+        QVector<qreal> sourceValues;
+        QVector<int> sourceSlices;
+        qreal otherValue = 0.0;
+
+        totals.insert(source, aggregateSlices(source, m_maximumSlices, sourceValues, sourceSlices, otherValue));
+
+        values << sourceValues;
+        slices << sourceSlices;
+        otherValues << otherValue;
+    }
 
     auto indexMode = indexingMode();
     auto colorIndex = 0;
-    auto range = m_range->calculateRange(valueSources(),
+    auto range = m_range->calculateRange(sources,
                                          [](ChartDataSource*) { return 0.0; },
-                                         maximum);
+                                         [&totals](ChartDataSource *source) { return totals.value(source); });
+
+    for (int sourceIndex = 0; sourceIndex < sources.size(); ++sourceIndex) {
+        const auto &sourceValues = values.at(sourceIndex);
 
-    for (auto source : sources) {
         qreal threshold = range.start;
         qreal total = 0.0;
 
         QVector<qreal> sections;
         QVector<QColor> sectionColors;
 
-        for (int i = 0; i < source->itemCount(); ++i) {
-            auto value = source->item(i).toReal();
+        for (auto index : slices.at(sourceIndex)) {
+            auto value = index >= 0 ? sourceValues.at(index) : otherValues.at(sourceIndex);
             auto limited = value - threshold;
             if (limited > 0.0) {
                 if (total + limited >= range.end) {
@@ -240,19 +365,19 @@ void PieChart::onDataChanged()
                 sections << limited;
                 total += limited;
 
-                auto color = colors->item(colorIndex).value<QColor>();
-                sectionColors << color;
+                if (index < 0) {
+                    sectionColors << m_otherColor;
+                } else {
+                    auto itemColorIndex = indexMode == IndexEachSource ? colorIndex : colorIndex + index;
+                    sectionColors << colors->item(itemColorIndex).value<QColor>();
+                }
             }
             threshold = std::max(0.0, threshold - value);
-
-            if (indexMode != IndexEachSource) {
-                colorIndex++;
-            }
         }
 
         if (qFuzzyCompare(total, 0.0)) {
-            m_sections << QVector<qreal>{0.0};
-            m_colors << QVector<QColor>{colors->item(colorIndex).value<QColor>()};
+            sections = QVector<qreal>{0.0};
+            sectionColors = QVector<QColor>{colors->item(colorIndex).value<QColor>()};
         }
 
         for (auto &value : sections) {
@@ -264,10 +389,24 @@ void PieChart::onDataChanged()
 
         if (indexMode == IndexEachSource) {
             colorIndex++;
-        } else if (indexMode == IndexSourceValues) {
-            colorIndex = 0;
+        } else if (indexMode == IndexAllValues) {
+            colorIndex += sourceValues.size();
         }
     }
 
+    updateSlices(slices, otherValues);
+
     update();
 }
+
+void PieChart::updateSlices(const QVector<QVector<int>> &slices, const QVector<qreal> &otherValues)
+{
+    m_otherValues = otherValues;
+
+    if (slices == m_slices) {
+        return;
+    }
+
+    m_slices = slices;
+    Q_EMIT slicesChanged();
+}
@@ -69,6 +69,22 @@ class PieChart : public Chart
      * Smooth the ends of sections.
      */
     Q_PROPERTY(bool smoothEnds READ smoothEnds WRITE setSmoothEnds NOTIFY smoothEndsChanged)
+    /**
+     * The maximum number of slices to display for each value source.
+     *
+     * If a value source contains more items than this, only the largest items are displayed as separate slices
+     * and all remaining items are combined into a single "other" slice. If less than or equal to zero (the
+     * default), all items are displayed.
+     */
+    Q_PROPERTY(int maximumSlices READ maximumSlices WRITE setMaximumSlices NOTIFY maximumSlicesChanged)
+    /**
+     * The name to use for the combined "other" slice.
+     */
+    Q_PROPERTY(QString otherName READ otherName WRITE setOtherName NOTIFY otherNameChanged)
+    /**
+     * The color to use for the combined "other" slice.
+     */
+    Q_PROPERTY(QColor otherColor READ otherColor WRITE setOtherColor NOTIFY otherColorChanged)
 
 public:
     /**
@@ -106,11 +122,44 @@ public:
     void setSmoothEnds(bool newSmoothEnds);
     Q_SIGNAL void smoothEndsChanged();
 
+    int maximumSlices() const;
+    void setMaximumSlices(int newMaximumSlices);
+    Q_SIGNAL void maximumSlicesChanged();
+
+    QString otherName() const;
+    void setOtherName(const QString &newOtherName);
+    Q_SIGNAL void otherNameChanged();
+
+    QColor otherColor() const;
+    void setOtherColor(const QColor &newOtherColor);
+    Q_SIGNAL void otherColorChanged();
+
+    /**
+     * The item indices of a value source that are displayed as slices, in display order.
+     *
+     * An index of -1 indicates the combined "other" slice.
+     *
+     * @param sourceIndex The index of the value source.
+     */
+    Q_INVOKABLE QVector<int> sliceIndices(int sourceIndex) const;
+    /**
+     * The combined value of all items of a value source that are part of the "other" slice.
+     *
+     * @param sourceIndex The index of the value source.
+     */
+    Q_INVOKABLE qreal otherValue(int sourceIndex) const;
+    /**
+     * Emitted when the mapping from items to slices changed.
+     */
+    Q_SIGNAL void slicesChanged();
+
 protected:
     QSGNode *updatePaintNode(QSGNode *node, UpdatePaintNodeData *data) override;
     void onDataChanged() override;
 
 private:
+    void updateSlices(const QVector<QVector<int>> &slices, const QVector<qreal> &otherValues);
+
     std::unique_ptr<RangeGroup> m_range;
     bool m_filled = false;
     qreal m_thickness = 10.0;
@@ -119,9 +168,14 @@ private:
     qreal m_fromAngle = 0.0;
     qreal m_toAngle = 360.0;
     bool m_smoothEnds = false;
+    int m_maximumSlices = -1;
+    QString m_otherName = QStringLiteral("Other");
+    QColor m_otherColor = Qt::gray;
 
     QVector<QVector<qreal>> m_sections;
     QVector<QVector<QColor>> m_colors;
+    QVector<QVector<int>> m_slices;
+    QVector<qreal> m_otherValues;
 };
 
 #endif // PIECHART_H
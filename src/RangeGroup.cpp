@@ -25,6 +25,25 @@
 
 #include <QVector>
 
+// The amount of steps a range is divided into when determining nice bounds.
+static const qreal NiceSubdivisions = 10.0;
+
+// Smallest number of the form 1, 2 or 5 times a power of ten that is at least value.
+static qreal niceStep(qreal value)
+{
+    const auto magnitude = std::pow(10.0, std::floor(std::log10(value)));
+    const auto fraction = value / magnitude;
+
+    if (fraction <= 1.0) {
+        return magnitude;
+    } else if (fraction <= 2.0) {
+        return 2.0 * magnitude;
+    } else if (fraction <= 5.0) {
+        return 5.0 * magnitude;
+    }
+    return 10.0 * magnitude;
+}
+
 RangeGroup::RangeGroup(QObject *parent)
     : QObject(parent)
 {
@@ -33,6 +52,13 @@ RangeGroup::RangeGroup(QObject *parent)
     connect(this, &RangeGroup::automaticChanged, this, &RangeGroup::rangeChanged);
     connect(this, &RangeGroup::minimumChanged, this, &RangeGroup::rangeChanged);
     connect(this, &RangeGroup::incrementChanged, this, &RangeGroup::rangeChanged);
+    connect(this, &RangeGroup::niceBoundsChanged, this, &RangeGroup::rangeChanged);
+    connect(this, &RangeGroup::hysteresisChanged, this, &RangeGroup::rangeChanged);
+
+    // The previous range no longer applies when any property changes.
+    connect(this, &RangeGroup::rangeChanged, this, [this]() {
+        m_previousValid = false;
+    });
 }
 
 qreal RangeGroup::from() const
@@ -115,6 +141,37 @@ void RangeGroup::setIncrement(qreal newIncrement)
     Q_EMIT incrementChanged();
 }
 
+bool RangeGroup::niceBounds() const
+{
+    return m_niceBounds;
+}
+
+void RangeGroup::setNiceBounds(bool newNiceBounds)
+{
+    if (newNiceBounds == m_niceBounds) {
+        return;
+    }
+
+    m_niceBounds = newNiceBounds;
+    Q_EMIT niceBoundsChanged();
+}
+
+qreal RangeGroup::hysteresis() const
+{
+    return m_hysteresis;
+}
+
+void RangeGroup::setHysteresis(qreal newHysteresis)
+{
+    newHysteresis = qBound(0.0, newHysteresis, 1.0);
+    if (qFuzzyCompare(newHysteresis, m_hysteresis)) {
+        return;
+    }
+
+    m_hysteresis = newHysteresis;
+    Q_EMIT hysteresisChanged();
+}
+
 bool RangeGroup::isValid() const
 {
     return m_automatic || (m_to > m_from);
@@ -140,6 +197,33 @@ RangeGroup::RangeResult RangeGroup::calculateRange(const QVector<ChartDataSource
     }
 
     max = std::max(max, m_minimum);
+
+    const bool usePolicies = m_automatic && max > min;
+
+    if (usePolicies && m_hysteresis > 0.0 && m_previousValid) {
+        // Keep the previous range as long as the values fit in it and do not
+        // use a lot less of it.
+        if (min >= m_previous.start && max <= m_previous.end && (max - min) >= m_previous.distance * (1.0 - m_hysteresis)) {
+            return m_previous;
+        }
+
+        // Grow with some headroom, so that the range does not need to change
+        // again for every small increase after this.
+        const auto headroom = (max - min) * m_hysteresis;
+        if (max > m_previous.end) {
+            max += headroom;
+        }
+        if (min < m_previous.start) {
+            min -= headroom;
+        }
+    }
+
+    if (usePolicies && m_niceBounds) {
+        const auto step = niceStep((max - min) / NiceSubdivisions);
+        min = step * std::floor(min / step);
+        max = step * std::ceil(max / step);
+    }
+
     if (m_increment > 0.0) {
         max = m_increment * std::ceil(max / m_increment);
     }
@@ -148,5 +232,29 @@ RangeGroup::RangeResult RangeGroup::calculateRange(const QVector<ChartDataSource
     result.end = max;
     result.distance = max - min;
 
+    if (usePolicies) {
+        m_previous = result;
+        m_previousValid = true;
+    }
+
+    return result;
+}
+
+QVector<qreal> RangeGroup::tickPositions(qreal step)
+{
+    if (!std::isfinite(step) || step * MaximumTicks < 1.0) {
+        return {0.0, 1.0};
+    }
+
+    QVector<qreal> result;
+    result.reserve(int(std::ceil(1.0 / step)) + 1);
+
+    // Stop slightly before the end so that rounding errors do not result in
+    // an extra tick right next to the last one.
+    for (int i = 0; i * step < 1.0 - step * 1e-3; ++i) {
+        result << i * step;
+    }
+    result << 1.0;
+
     return result;
 }
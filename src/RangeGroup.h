@@ -61,6 +61,25 @@ class RangeGroup : public QObject
      * The amount with which the range increases. That is, the total range will be limited to a multiple of this value.
      */
     Q_PROPERTY(qreal increment READ increment WRITE setIncrement NOTIFY incrementChanged)
+    /**
+     * Whether to extend the range to "nice" values. Only used when automatic is true.
+     *
+     * If true, the start and end of the range are rounded outwards to a
+     * multiple of a step of 1, 2 or 5 times a power of ten, chosen so the
+     * range is divided into roughly ten steps.
+     */
+    Q_PROPERTY(bool niceBounds READ niceBounds WRITE setNiceBounds NOTIFY niceBoundsChanged)
+    /**
+     * How much the range should lag behind changes to the values, as a fraction of the range.
+     * Only used when automatic is true.
+     *
+     * When the values grow beyond the current range, the range grows right
+     * away and gains this fraction as headroom. When the values shrink, the
+     * current range is kept until the values use less than `1 - hysteresis`
+     * of it. This avoids changing the range for every small change in the
+     * values. The default of 0 means the range always follows the values.
+     */
+    Q_PROPERTY(qreal hysteresis READ hysteresis WRITE setHysteresis NOTIFY hysteresisChanged)
 
 public:
     struct RangeResult {
@@ -93,6 +112,14 @@ public:
     void setIncrement(qreal newIncrement);
     Q_SIGNAL void incrementChanged();
 
+    bool niceBounds() const;
+    void setNiceBounds(bool newNiceBounds);
+    Q_SIGNAL void niceBoundsChanged();
+
+    qreal hysteresis() const;
+    void setHysteresis(qreal newHysteresis);
+    Q_SIGNAL void hysteresisChanged();
+
     bool isValid() const;
 
     Q_SIGNAL void rangeChanged();
@@ -101,12 +128,31 @@ public:
                                std::function<qreal(ChartDataSource*)> minimumCallback,
                                std::function<qreal(ChartDataSource*)> maximumCallback);
 
+    /**
+     * The maximum amount of ticks returned by tickPositions().
+     */
+    static const int MaximumTicks = 10000;
+
+    /**
+     * Calculate tick positions as fractions of the length of an axis.
+     *
+     * The first tick is at 0 and the last tick at 1, with a tick every
+     * \p step in between. If \p step is not valid or smaller than
+     * 1 / MaximumTicks, only the first and last tick are returned.
+     */
+    static QVector<qreal> tickPositions(qreal step);
+
 private:
     qreal m_from = 0.0;
     qreal m_to = 100.0;
     bool m_automatic = true;
     qreal m_minimum = std::numeric_limits<qreal>::min();
     qreal m_increment = 0.0;
+    bool m_niceBounds = false;
+    qreal m_hysteresis = 0.0;
+    // The previous automatic range, used for hysteresis.
+    bool m_previousValid = false;
+    RangeResult m_previous;
 };
 
 #endif // RANGEGROUP_H
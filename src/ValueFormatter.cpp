@@ -0,0 +1,152 @@
+/*
+ * This file is part of Quick Charts.
+ * Copyright 2019 Arjen Hiemstra <ahiemstra@heimr.nl>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License or (at your option) version 3 or any later version
+ * accepted by the membership of KDE e.V. (or its successor approved
+ * by the membership of KDE e.V.), which shall act as a proxy
+ * defined in Section 14 of version 3 of the license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ValueFormatter.h"
+
+#include <cmath>
+
+#include <QVariant>
+
+ValueFormatter::ValueFormatter(QObject *parent)
+    : QObject(parent)
+{
+    connect(this, &ValueFormatter::unitChanged, this, &ValueFormatter::formatChanged);
+    connect(this, &ValueFormatter::decimalsChanged, this, &ValueFormatter::formatChanged);
+    connect(this, &ValueFormatter::prefixChanged, this, &ValueFormatter::formatChanged);
+    connect(this, &ValueFormatter::localeNameChanged, this, &ValueFormatter::formatChanged);
+}
+
+QString ValueFormatter::unit() const
+{
+    return m_unit;
+}
+
+void ValueFormatter::setUnit(const QString &newUnit)
+{
+    if (newUnit == m_unit) {
+        return;
+    }
+
+    m_unit = newUnit;
+    Q_EMIT unitChanged();
+}
+
+int ValueFormatter::decimals() const
+{
+    return m_decimals;
+}
+
+void ValueFormatter::setDecimals(int newDecimals)
+{
+    if (newDecimals == m_decimals) {
+        return;
+    }
+
+    m_decimals = newDecimals;
+    Q_EMIT decimalsChanged();
+}
+
+ValueFormatter::Prefix ValueFormatter::prefix() const
+{
+    return m_prefix;
+}
+
+void ValueFormatter::setPrefix(Prefix newPrefix)
+{
+    if (newPrefix == m_prefix) {
+        return;
+    }
+
+    m_prefix = newPrefix;
+    Q_EMIT prefixChanged();
+}
+
+QString ValueFormatter::localeName() const
+{
+    return m_localeName;
+}
+
+void ValueFormatter::setLocaleName(const QString &newLocaleName)
+{
+    if (newLocaleName == m_localeName) {
+        return;
+    }
+
+    m_localeName = newLocaleName;
+    m_locale = m_localeName.isEmpty() ? QLocale{} : QLocale{m_localeName};
+    Q_EMIT localeNameChanged();
+}
+
+QString ValueFormatter::format(const QVariant &value) const
+{
+    bool ok = false;
+    auto number = value.toDouble(&ok);
+    if (!ok) {
+        return value.toString();
+    }
+
+    return formatNumber(number);
+}
+
+QString ValueFormatter::formatNumber(qreal number) const
+{
+    static const QStringList metricLarge = {
+        QString{}, QStringLiteral("k"), QStringLiteral("M"), QStringLiteral("G"), QStringLiteral("T"), QStringLiteral("P"),
+    };
+    static const QStringList metricSmall = {
+        QString{}, QStringLiteral("m"), QStringLiteral("\u00B5"), QStringLiteral("n"), QStringLiteral("p"),
+    };
+    static const QStringList binaryLarge = {
+        QString{}, QStringLiteral("Ki"), QStringLiteral("Mi"), QStringLiteral("Gi"), QStringLiteral("Ti"), QStringLiteral("Pi"),
+    };
+
+    QString prefix;
+    auto scaled = number;
+
+    if (m_prefix != NoPrefix && !qFuzzyIsNull(number)) {
+        const auto base = m_prefix == MetricPrefix ? 1000.0 : 1024.0;
+        const auto &large = m_prefix == MetricPrefix ? metricLarge : binaryLarge;
+        // Binary prefixes are only used for sizes, which are never fractional.
+        const auto smallCount = m_prefix == MetricPrefix ? metricSmall.size() : 1;
+
+        auto magnitude = std::abs(number);
+        int exponent = 0;
+        while (magnitude >= base && exponent < large.size() - 1) {
+            magnitude /= base;
+            exponent++;
+        }
+        while (magnitude < 1.0 && -exponent < smallCount - 1) {
+            magnitude *= base;
+            exponent--;
+        }
+
+        scaled = number / std::pow(base, exponent);
+        prefix = exponent >= 0 ? large.at(exponent) : metricSmall.at(-exponent);
+    }
+
+    auto text = m_decimals >= 0 ? m_locale.toString(scaled, 'f', m_decimals) : m_locale.toString(scaled, 'g', QLocale::FloatingPointShortest);
+
+    if (prefix.isEmpty() && m_unit.isEmpty()) {
+        return text;
+    }
+
+    return text + QLatin1Char(' ') + prefix + m_unit;
+}
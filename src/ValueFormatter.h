@@ -0,0 +1,106 @@
+/*
+ * This file is part of Quick Charts.
+ * Copyright 2019 Arjen Hiemstra <ahiemstra@heimr.nl>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License or (at your option) version 3 or any later version
+ * accepted by the membership of KDE e.V. (or its successor approved
+ * by the membership of KDE e.V.), which shall act as a proxy
+ * defined in Section 14 of version 3 of the license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef VALUEFORMATTER_H
+#define VALUEFORMATTER_H
+
+#include <QLocale>
+#include <QObject>
+
+/**
+ * An object that converts values to text for display.
+ *
+ * This can be used by LegendModel, AxisLabels and ChartAxisSource to format
+ * values without needing to call into JavaScript for every value.
+ */
+class ValueFormatter : public QObject
+{
+    Q_OBJECT
+    /**
+     * The unit to display after values, for example "B" or "%".
+     */
+    Q_PROPERTY(QString unit READ unit WRITE setUnit NOTIFY unitChanged)
+    /**
+     * The amount of decimals to display.
+     *
+     * If negative, the default, as many decimals as needed are displayed.
+     */
+    Q_PROPERTY(int decimals READ decimals WRITE setDecimals NOTIFY decimalsChanged)
+    /**
+     * Which prefixes to use to scale large or small values. Defaults to NoPrefix.
+     */
+    Q_PROPERTY(Prefix prefix READ prefix WRITE setPrefix NOTIFY prefixChanged)
+    /**
+     * The name of the locale to use for formatting, for example "nl_NL".
+     *
+     * If empty, the default, the default locale is used.
+     */
+    Q_PROPERTY(QString localeName READ localeName WRITE setLocaleName NOTIFY localeNameChanged)
+
+public:
+    enum Prefix {
+        NoPrefix, ///< Display values as they are.
+        MetricPrefix, ///< Scale values by powers of 1000 and use SI prefixes like k, M and m.
+        BinaryPrefix ///< Scale values by powers of 1024 and use binary prefixes like Ki and Mi.
+    };
+    Q_ENUM(Prefix)
+
+    explicit ValueFormatter(QObject *parent = nullptr);
+
+    QString unit() const;
+    void setUnit(const QString &newUnit);
+    Q_SIGNAL void unitChanged();
+
+    int decimals() const;
+    void setDecimals(int newDecimals);
+    Q_SIGNAL void decimalsChanged();
+
+    Prefix prefix() const;
+    void setPrefix(Prefix newPrefix);
+    Q_SIGNAL void prefixChanged();
+
+    QString localeName() const;
+    void setLocaleName(const QString &newLocaleName);
+    Q_SIGNAL void localeNameChanged();
+
+    /**
+     * Emitted when any property that affects the result of format() changes.
+     */
+    Q_SIGNAL void formatChanged();
+
+    /**
+     * Convert a value to text.
+     *
+     * Values that cannot be converted to a number are returned as they are.
+     */
+    Q_INVOKABLE QString format(const QVariant &value) const;
+
+private:
+    QString formatNumber(qreal number) const;
+
+    QString m_unit;
+    int m_decimals = -1;
+    Prefix m_prefix = NoPrefix;
+    QString m_localeName;
+    QLocale m_locale;
+};
+
+#endif // VALUEFORMATTER_H
@@ -34,9 +34,13 @@ XYChart::XYChart(QQuickItem *parent)
     : Chart(parent)
 {
     m_xRange = new RangeGroup{this};
-    connect(m_xRange, &RangeGroup::rangeChanged, this, &XYChart::updateComputedRange);
+    connect(m_xRange, &RangeGroup::rangeChanged, this, [this]() {
+        invalidate(RangeDirty);
+    });
     m_yRange = new RangeGroup{this};
-    connect(m_yRange, &RangeGroup::rangeChanged, this, &XYChart::updateComputedRange);
+    connect(m_yRange, &RangeGroup::rangeChanged, this, [this]() {
+        invalidate(RangeDirty);
+    });
 }
 
 RangeGroup *XYChart::xRange() const
@@ -61,7 +65,7 @@ void XYChart::setDirection(XYChart::Direction newDirection)
     }
 
     m_direction = newDirection;
-    onDataChanged();
+    invalidate(DataDirty);
     Q_EMIT directionChanged();
 }
 
@@ -77,7 +81,7 @@ void XYChart::setStacked(bool newStacked)
     }
 
     m_stacked = newStacked;
-    onDataChanged();
+    invalidate(DataDirty | RangeDirty);
     Q_EMIT stackedChanged();
 }
 
@@ -86,36 +90,49 @@ ComputedRange XYChart::computedRange() const
     return m_computedRange;
 }
 
+void XYChart::processChanges(DirtyFlags flags)
+{
+    // The computed range is shared by everything that depends on the data,
+    // so make sure it is up to date before anything else is processed.
+    if (flags & (DataDirty | RangeDirty)) {
+        updateComputedRange();
+    }
+
+    Chart::processChanges(flags);
+}
+
 void XYChart::updateComputedRange()
 {
     ComputedRange result;
 
-    auto xRange = m_xRange->calculateRange(valueSources(),
+    const auto sources = valueSources();
+    ChartDataSource::updateStatistics(sources);
+
+    auto xRange = m_xRange->calculateRange(sources,
                                            [](ChartDataSource *) { return 0; },
                                            [](ChartDataSource *source) { return source->itemCount(); });
     result.startX = xRange.start;
     result.endX = xRange.end;
     result.distanceX = xRange.distance;
 
-    auto maximumY = [this, xRange](ChartDataSource *source) {
-        if (!m_stacked) {
-            return source->maximum().toDouble();
-        } else {
-            qreal max = std::numeric_limits<qreal>::min();
-            for (int i = xRange.start; i < xRange.end; ++i) {
-                qreal yDistance = 0.0;
-                for (auto source : valueSources()) {
-                    yDistance += source->item(i).toDouble();
-                }
-                max = std::max(max, yDistance);
+    // The stacked maximum does not depend on individual sources, so only
+    // calculate it once.
+    qreal stackedMaximum = std::numeric_limits<qreal>::min();
+    if (m_stacked && m_yRange->automatic()) {
+        for (int i = xRange.start; i < xRange.end; ++i) {
+            qreal yDistance = 0.0;
+            for (auto source : sources) {
+                yDistance += source->item(i).toDouble();
             }
-            return max;
+            stackedMaximum = std::max(stackedMaximum, yDistance);
         }
-    };
+    }
 
-    auto yRange = m_yRange->calculateRange(valueSources(),
-                                           [](ChartDataSource *source) { return std::min(0.0, source->minimum().toDouble()); },
-                                           maximumY);
+    auto yRange = m_yRange->calculateRange(sources,
+                                           [](ChartDataSource *source) { return std::min(0.0, source->statistics().minimum); },
+                                           [this, stackedMaximum](ChartDataSource *source) {
+                                               return m_stacked ? stackedMaximum : source->statistics().maximum;
+                                           });
     result.startY = yRange.start;
     result.endY = yRange.end;
     result.distanceY = yRange.distance;
@@ -125,9 +142,27 @@ void XYChart::updateComputedRange()
     }
 
     m_computedRange = result;
+    m_ticks.clear();
     Q_EMIT computedRangeChanged();
 }
 
+QVector<qreal> XYChart::ticks(Qt::Orientation orientation, qreal interval) const
+{
+    const auto key = qMakePair(int(orientation), interval);
+    auto itr = m_ticks.constFind(key);
+    if (itr != m_ticks.constEnd()) {
+        return itr.value();
+    }
+
+    // The X axis has a point per item, so there is one interval less than the
+    // amount of items.
+    const auto distance = orientation == Qt::Horizontal ? qreal(m_computedRange.distanceX - 1) : qreal(m_computedRange.distanceY);
+
+    auto result = RangeGroup::tickPositions(distance > 0.0 ? interval / distance : 0.0);
+    m_ticks.insert(key, result);
+    return result;
+}
+
 QDebug operator<<(QDebug debug, const ComputedRange &range)
 {
     debug << "Range: startX" << range.startX << "endX" << range.endX << "distance" << range.distanceX << "startY" << range.startY << "endY"
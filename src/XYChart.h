@@ -22,6 +22,8 @@
 #ifndef XYCHART_H
 #define XYCHART_H
 
+#include <QHash>
+
 #include "Chart.h"
 
 class RangeGroup;
@@ -100,7 +102,20 @@ public:
     ComputedRange computedRange() const;
     Q_SIGNAL void computedRangeChanged();
 
+    /**
+     * Tick positions along one of the axes of this chart.
+     *
+     * This returns a tick every \p interval values along the axis, as
+     * fractions of the length of the axis. Ticks are cached until the
+     * computed range changes, so anything displaying ticks for this chart can
+     * share them.
+     *
+     * @see RangeGroup::tickPositions()
+     */
+    QVector<qreal> ticks(Qt::Orientation orientation, qreal interval) const;
+
 protected:
+    void processChanges(DirtyFlags flags) override;
     virtual void updateComputedRange();
 
 private:
@@ -109,6 +124,7 @@ private:
     Direction m_direction = Direction::ZeroAtStart;
     bool m_stacked = false;
     ComputedRange m_computedRange;
+    mutable QHash<QPair<int, qreal>, QVector<qreal>> m_ticks;
 };
 
 QDebug operator<<(QDebug debug, const ComputedRange &range);
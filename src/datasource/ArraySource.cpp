@@ -49,6 +49,11 @@ QVariant ArraySource::maximum() const
     return *std::max_element(m_array.begin(), m_array.end());
 }
 
+bool ArraySource::supportsConcurrentAccess() const
+{
+    return true;
+}
+
 QVariantList ArraySource::array() const
 {
     return m_array;
@@ -47,6 +47,7 @@ public:
     virtual QVariant item(int index) const override;
     QVariant minimum() const override;
     QVariant maximum() const override;
+    bool supportsConcurrentAccess() const override;
 
     QVariantList array() const;
     void setArray(const QVariantList &array);
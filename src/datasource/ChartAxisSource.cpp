@@ -24,6 +24,8 @@
 #include <QDebug>
 #include <QVariant>
 
+#include "RangeGroup.h"
+#include "ValueFormatter.h"
 #include "XYChart.h"
 
 ChartAxisSource::ChartAxisSource(QObject *parent)
@@ -32,19 +34,26 @@ ChartAxisSource::ChartAxisSource(QObject *parent)
     connect(this, &ChartAxisSource::itemCountChanged, this, &ChartAxisSource::dataChanged);
     connect(this, &ChartAxisSource::chartChanged, this, &ChartAxisSource::dataChanged);
     connect(this, &ChartAxisSource::axisChanged, this, &ChartAxisSource::dataChanged);
+    connect(this, &ChartAxisSource::formatterChanged, this, &ChartAxisSource::dataChanged);
 }
 
 QVariant ChartAxisSource::item(int index) const
 {
-    if (!m_chart || index < 0 || index > m_itemCount)
+    if (!m_chart || index < 0 || index >= m_itemCount)
         return QVariant{};
 
     auto range = m_chart->computedRange();
+    auto position = positions().value(index);
+    QVariant value;
     if (m_axis == Axis::XAxis) {
-        return range.startX + (range.distanceX / (m_itemCount - 1)) * index;
+        // The X axis has a point per item, so the last item is at one less
+        // than the distance, matching XYChart::ticks().
+        value = range.startX + qRound((range.distanceX - 1) * position);
     } else {
-        return range.startY + (range.distanceY / (m_itemCount - 1)) * index;
+        value = range.startY + range.distanceY * position;
     }
+
+    return m_formatter ? m_formatter->format(value) : value;
 }
 
 QVariant ChartAxisSource::minimum() const
@@ -115,6 +124,13 @@ int ChartAxisSource::itemCount() const
 
 void ChartAxisSource::setItemCount(int newItemCount)
 {
+    // Ticks are not calculated for more items than this, so any items past it
+    // would not have a position.
+    if (newItemCount > RangeGroup::MaximumTicks) {
+        qWarning() << "ChartAxisSource: itemCount" << newItemCount << "is larger than the maximum of" << RangeGroup::MaximumTicks;
+        newItemCount = RangeGroup::MaximumTicks;
+    }
+
     if (newItemCount == m_itemCount) {
         return;
     }
@@ -122,3 +138,42 @@ void ChartAxisSource::setItemCount(int newItemCount)
     m_itemCount = newItemCount;
     Q_EMIT itemCountChanged();
 }
+
+ValueFormatter *ChartAxisSource::formatter() const
+{
+    return m_formatter;
+}
+
+void ChartAxisSource::setFormatter(ValueFormatter *newFormatter)
+{
+    if (newFormatter == m_formatter) {
+        return;
+    }
+
+    if (m_formatter) {
+        m_formatter->disconnect(this);
+    }
+
+    m_formatter = newFormatter;
+
+    if (m_formatter) {
+        connect(m_formatter, &ValueFormatter::formatChanged, this, &ChartAxisSource::dataChanged);
+        connect(m_formatter, &QObject::destroyed, this, &ChartAxisSource::dataChanged);
+    }
+
+    Q_EMIT formatterChanged();
+}
+
+QVector<qreal> ChartAxisSource::positions() const
+{
+    if (!m_chart || m_itemCount < 2) {
+        return RangeGroup::tickPositions(1.0 / (m_itemCount - 1));
+    }
+
+    const auto range = m_chart->computedRange();
+    if (m_axis == Axis::XAxis) {
+        return m_chart->ticks(Qt::Horizontal, (range.distanceX - 1) / qreal(m_itemCount - 1));
+    } else {
+        return m_chart->ticks(Qt::Vertical, range.distanceY / qreal(m_itemCount - 1));
+    }
+}
@@ -22,8 +22,11 @@
 #ifndef CHARTAXISSOURCE_H
 #define CHARTAXISSOURCE_H
 
+#include <QPointer>
+
 #include "ChartDataSource.h"
 
+class ValueFormatter;
 class XYChart;
 
 /**
@@ -35,6 +38,13 @@ class ChartAxisSource : public ChartDataSource
     Q_PROPERTY(XYChart *chart READ chart WRITE setChart NOTIFY chartChanged)
     Q_PROPERTY(ChartAxisSource::Axis axis READ axis WRITE setAxis NOTIFY axisChanged)
     Q_PROPERTY(int itemCount READ itemCount WRITE setItemCount NOTIFY itemCountChanged)
+    /**
+     * The formatter used to convert items to text.
+     *
+     * If set, items are provided as formatted strings instead of numbers.
+     * minimum and maximum are not affected.
+     */
+    Q_PROPERTY(ValueFormatter *formatter READ formatter WRITE setFormatter NOTIFY formatterChanged)
 
 public:
     enum class Axis { XAxis, YAxis };
@@ -63,10 +73,26 @@ public:
     Q_SLOT void setItemCount(int newItemCount);
     Q_SIGNAL void itemCountChanged();
 
+    ValueFormatter *formatter() const;
+    Q_SLOT void setFormatter(ValueFormatter *newFormatter);
+    Q_SIGNAL void formatterChanged();
+
+    /**
+     * The position of each item along the axis, as a fraction of its length.
+     *
+     * These are the ticks of the chart for an interval that results in
+     * itemCount items, so anything displaying the items of this source can
+     * place them at the same positions.
+     *
+     * @see XYChart::ticks()
+     */
+    QVector<qreal> positions() const;
+
 private:
     XYChart *m_chart = nullptr;
     Axis m_axis = Axis::XAxis;
     int m_itemCount = 2;
+    QPointer<ValueFormatter> m_formatter;
 };
 
 #endif // ARRAYSOURCE_H
@@ -21,7 +21,132 @@
 
 #include "ChartDataSource.h"
 
+#include <algorithm>
+#include <atomic>
+#include <limits>
+
+#include <QRunnable>
+#include <QSemaphore>
+#include <QThreadPool>
+
+static quint64 nextRevision()
+{
+    static std::atomic<quint64> lastRevision{0};
+    return ++lastRevision;
+}
+
+class StatisticsJob : public QRunnable
+{
+public:
+    StatisticsJob(const ChartDataSource *source, QSemaphore *semaphore)
+        : m_source(source)
+        , m_semaphore(semaphore)
+    {
+    }
+
+    void run() override
+    {
+        m_source->statistics();
+        m_semaphore->release();
+    }
+
+private:
+    const ChartDataSource *m_source;
+    QSemaphore *m_semaphore;
+};
+
 ChartDataSource::ChartDataSource(QObject *parent)
     : QObject(parent)
+    , m_revision(nextRevision())
+{
+    // Connected before anything else, so the revision is updated before any
+    // other receivers are notified.
+    connect(this, &ChartDataSource::dataChanged, this, [this]() { m_revision = nextRevision(); });
+}
+
+bool ChartDataSource::supportsConcurrentAccess() const
+{
+    return false;
+}
+
+quint64 ChartDataSource::revision() const
+{
+    return m_revision;
+}
+
+SourceStatistics ChartDataSource::statistics() const
+{
+    if (m_statisticsRevision != m_revision) {
+        m_statistics = computeStatistics();
+        m_statisticsRevision = m_revision;
+    }
+
+    return m_statistics;
+}
+
+void ChartDataSource::updateStatistics(const QVector<ChartDataSource *> &sources)
 {
+    QVector<ChartDataSource *> concurrent;
+
+    for (auto source : sources) {
+        if (!source || source->m_statisticsRevision == source->m_revision) {
+            continue;
+        }
+
+        if (source->supportsConcurrentAccess()) {
+            if (!concurrent.contains(source)) {
+                concurrent << source;
+            }
+        } else {
+            source->statistics();
+        }
+    }
+
+    if (concurrent.size() < 2) {
+        std::for_each(concurrent.cbegin(), concurrent.cend(), [](ChartDataSource *source) { source->statistics(); });
+        return;
+    }
+
+    // The first source is processed on this thread, so it does not only wait.
+    // If the pool has no thread available, sources are processed here as well.
+    QSemaphore semaphore;
+    auto pool = QThreadPool::globalInstance();
+    for (int i = 1; i < concurrent.size(); ++i) {
+        auto job = new StatisticsJob{concurrent.at(i), &semaphore};
+        if (!pool->tryStart(job)) {
+            job->run();
+            delete job;
+        }
+    }
+
+    concurrent.first()->statistics();
+    semaphore.acquire(concurrent.size() - 1);
+}
+
+SourceStatistics ChartDataSource::computeStatistics() const
+{
+    SourceStatistics result;
+    result.minimum = std::numeric_limits<qreal>::max();
+    result.maximum = std::numeric_limits<qreal>::lowest();
+
+    const auto count = itemCount();
+    for (int i = 0; i < count; ++i) {
+        auto ok = false;
+        auto value = item(i).toDouble(&ok);
+        if (!ok) {
+            continue;
+        }
+
+        result.minimum = std::min(result.minimum, value);
+        result.maximum = std::max(result.maximum, value);
+        result.sum += value;
+        result.count++;
+    }
+
+    if (result.count == 0) {
+        result.minimum = 0.0;
+        result.maximum = 0.0;
+    }
+
+    return result;
 }
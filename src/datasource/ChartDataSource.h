@@ -23,6 +23,17 @@
 #define DATASOURCE_H
 
 #include <QObject>
+#include <QVector>
+
+/**
+ * Statistics of the values of a data source.
+ */
+struct SourceStatistics {
+    qreal minimum = 0.0;
+    qreal maximum = 0.0;
+    qreal sum = 0.0;
+    int count = 0;
+};
 
 /**
  * Abstract base class for data sources.
@@ -35,12 +46,58 @@ public:
     explicit ChartDataSource(QObject *parent = nullptr);
     virtual ~ChartDataSource() = default;
 
-    virtual int itemCount() const = 0;
-    virtual QVariant item(int index) const = 0;
-    virtual QVariant minimum() const = 0;
-    virtual QVariant maximum() const = 0;
+    Q_INVOKABLE virtual int itemCount() const = 0;
+    Q_INVOKABLE virtual QVariant item(int index) const = 0;
+    Q_INVOKABLE virtual QVariant minimum() const = 0;
+    Q_INVOKABLE virtual QVariant maximum() const = 0;
+
+    /**
+     * Whether item() can safely be called from a different thread, as long as
+     * the thread owning this source does not modify it at the same time.
+     *
+     * The default implementation returns false.
+     */
+    virtual bool supportsConcurrentAccess() const;
+
+    /**
+     * A number that increases every time the data of this source changes.
+     *
+     * Revisions are unique across all sources, so comparing revisions also
+     * detects when one source was replaced by another.
+     */
+    quint64 revision() const;
+
+    /**
+     * The statistics of all values of this source.
+     *
+     * These are computed when needed and cached until the data changes.
+     */
+    SourceStatistics statistics() const;
+
+    /**
+     * Make sure the statistics of several sources are up to date.
+     *
+     * Outdated statistics of sources that support concurrent access are
+     * computed in parallel using the global thread pool.
+     */
+    static void updateStatistics(const QVector<ChartDataSource *> &sources);
 
     Q_SIGNAL void dataChanged();
+
+protected:
+    /**
+     * Compute the statistics of all values of this source.
+     *
+     * The default implementation computes everything in a single pass over all
+     * items. Sources that determine their minimum or maximum differently
+     * should reimplement this.
+     */
+    virtual SourceStatistics computeStatistics() const;
+
+private:
+    quint64 m_revision = 0;
+    mutable quint64 m_statisticsRevision = 0;
+    mutable SourceStatistics m_statistics;
 };
 
 #endif // DATASOURCE_H
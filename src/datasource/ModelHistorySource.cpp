@@ -60,6 +60,11 @@ QVariant ModelHistorySource::maximum() const
     return *std::max_element(m_history.begin(), m_history.end());
 }
 
+bool ModelHistorySource::supportsConcurrentAccess() const
+{
+    return true;
+}
+
 int ModelHistorySource::row() const
 {
     return m_row;
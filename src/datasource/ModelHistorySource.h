@@ -40,6 +40,7 @@ public:
     virtual QVariant item(int index) const override;
     virtual QVariant minimum() const override;
     virtual QVariant maximum() const override;
+    virtual bool supportsConcurrentAccess() const override;
 
     int row() const;
     void setRow(int row);
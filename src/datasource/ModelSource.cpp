@@ -133,6 +133,25 @@ QVariant ModelSource::maximum() const
     return result;
 }
 
+SourceStatistics ModelSource::computeStatistics() const
+{
+    auto result = ChartDataSource::computeStatistics();
+    if (result.count <= 0)
+        return result;
+
+    // Models can provide their own minimum and maximum, see minimum() and maximum().
+    auto minProperty = m_model->property("minimum");
+    auto maxProperty = m_model->property("maximum");
+    if (minProperty.isValid() && minProperty != maxProperty) {
+        result.minimum = minProperty.toDouble();
+    }
+    if (maxProperty.isValid() && maxProperty != minProperty) {
+        result.maximum = maxProperty.toDouble();
+    }
+
+    return result;
+}
+
 void ModelSource::setRole(int role)
 {
     if (role == m_role) {
@@ -68,6 +68,9 @@ public:
     virtual QVariant minimum() const override;
     virtual QVariant maximum() const override;
 
+protected:
+    SourceStatistics computeStatistics() const override;
+
 private:
     mutable int m_role = -1;
     QString m_roleName;
@@ -47,6 +47,11 @@ QVariant SingleValueSource::maximum() const
     return m_value;
 }
 
+bool SingleValueSource::supportsConcurrentAccess() const
+{
+    return true;
+}
+
 QVariant SingleValueSource::value() const
 {
     return m_value;
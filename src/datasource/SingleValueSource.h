@@ -41,6 +41,7 @@ public:
     virtual QVariant item(int index) const override;
     QVariant minimum() const override;
     QVariant maximum() const override;
+    bool supportsConcurrentAccess() const override;
 
     QVariant value() const;
     void setValue(const QVariant &value);
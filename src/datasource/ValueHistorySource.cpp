@@ -21,6 +21,8 @@
 
 #include "ValueHistorySource.h"
 
+#include <algorithm>
+
 #include <QDebug>
 
 ValueHistorySource::ValueHistorySource(QObject *parent)
@@ -60,6 +62,11 @@ QVariant ValueHistorySource::maximum() const
     return QVariant{};
 }
 
+bool ValueHistorySource::supportsConcurrentAccess() const
+{
+    return true;
+}
+
 QVariant ValueHistorySource::value() const
 {
     return m_value;
@@ -67,6 +74,14 @@ QVariant ValueHistorySource::value() const
 
 void ValueHistorySource::setValue(const QVariant &newValue)
 {
+    // Adding a value to a full history that only contains that value does not
+    // change anything, so avoid notifying about it.
+    if (m_history.size() >= m_maximumHistory
+        && std::all_of(m_history.cbegin(), m_history.cend(), [&newValue](const QVariant &value) { return value == newValue; })) {
+        m_value = newValue;
+        return;
+    }
+
     m_value = newValue;
 
     m_history.prepend(newValue);
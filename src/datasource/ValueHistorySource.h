@@ -43,6 +43,7 @@ public:
     QVariant item(int index) const override;
     QVariant minimum() const override;
     QVariant maximum() const override;
+    bool supportsConcurrentAccess() const override;
 
     QVariant value() const;
     void setValue(const QVariant &value);
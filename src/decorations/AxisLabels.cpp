@@ -22,7 +22,15 @@
 #include "AxisLabels.h"
 
 #include <QDebug>
-
+#include <QFontMetricsF>
+#include <QLocale>
+#include <QPainter>
+#include <QQuickWindow>
+#include <QSGSimpleTextureNode>
+
+#include "RangeGroup.h"
+#include "ValueFormatter.h"
+#include "datasource/ChartAxisSource.h"
 #include "datasource/ChartDataSource.h"
 #include <QQmlContext>
 
@@ -155,6 +163,104 @@ void AxisLabels::setConstrainToBounds(bool newConstrainToBounds)
     Q_EMIT constrainToBoundsChanged();
 }
 
+AxisLabels::RenderMode AxisLabels::renderMode() const
+{
+    return m_renderMode;
+}
+
+void AxisLabels::setRenderMode(AxisLabels::RenderMode newRenderMode)
+{
+    if (newRenderMode == m_renderMode) {
+        return;
+    }
+
+    m_renderMode = newRenderMode;
+    setFlag(QQuickItem::ItemHasContents, m_renderMode == RenderMode::Native);
+
+    qDeleteAll(m_labels);
+    m_labels.clear();
+    m_labelTexts.clear();
+    invalidateLabels();
+    update();
+
+    Q_EMIT renderModeChanged();
+}
+
+QFont AxisLabels::font() const
+{
+    return m_font;
+}
+
+void AxisLabels::setFont(const QFont &newFont)
+{
+    if (newFont == m_font) {
+        return;
+    }
+
+    m_font = newFont;
+    scheduleLayout();
+    Q_EMIT fontChanged();
+}
+
+QColor AxisLabels::color() const
+{
+    return m_color;
+}
+
+void AxisLabels::setColor(const QColor &newColor)
+{
+    if (newColor == m_color) {
+        return;
+    }
+
+    m_color = newColor;
+    m_textureDirty = true;
+    update();
+    Q_EMIT colorChanged();
+}
+
+int AxisLabels::decimals() const
+{
+    return m_decimals;
+}
+
+void AxisLabels::setDecimals(int newDecimals)
+{
+    if (newDecimals == m_decimals) {
+        return;
+    }
+
+    m_decimals = newDecimals;
+    invalidateLabels();
+    Q_EMIT decimalsChanged();
+}
+
+ValueFormatter *AxisLabels::formatter() const
+{
+    return m_formatter;
+}
+
+void AxisLabels::setFormatter(ValueFormatter *newFormatter)
+{
+    if (newFormatter == m_formatter) {
+        return;
+    }
+
+    if (m_formatter) {
+        m_formatter->disconnect(this);
+    }
+
+    m_formatter = newFormatter;
+
+    if (m_formatter) {
+        connect(m_formatter, &ValueFormatter::formatChanged, this, &AxisLabels::invalidateLabels);
+        connect(m_formatter, &QObject::destroyed, this, &AxisLabels::invalidateLabels);
+    }
+
+    invalidateLabels();
+    Q_EMIT formatterChanged();
+}
+
 void AxisLabels::geometryChanged(const QRectF &newGeometry, const QRectF &oldGeometry)
 {
     QQuickItem::geometryChanged(newGeometry, oldGeometry);
@@ -164,6 +270,49 @@ void AxisLabels::geometryChanged(const QRectF &newGeometry, const QRectF &oldGeo
     }
 }
 
+QSGNode *AxisLabels::updatePaintNode(QSGNode *node, QQuickItem::UpdatePaintNodeData *data)
+{
+    Q_UNUSED(data);
+
+    if (m_renderMode != RenderMode::Native || m_labelTexts.isEmpty() || width() <= 0.0 || height() <= 0.0) {
+        delete node;
+        return nullptr;
+    }
+
+    auto textureNode = static_cast<QSGSimpleTextureNode *>(node);
+    if (!textureNode) {
+        textureNode = new QSGSimpleTextureNode{};
+        textureNode->setOwnsTexture(true);
+        m_textureDirty = true;
+    }
+
+    // All labels are rendered into a single texture, which only needs to be
+    // updated when the labels or their layout change.
+    if (m_textureDirty) {
+        const auto ratio = window()->effectiveDevicePixelRatio();
+
+        QImage image((size() * ratio).toSize(), QImage::Format_ARGB32_Premultiplied);
+        image.setDevicePixelRatio(ratio);
+        image.fill(Qt::transparent);
+
+        QPainter painter(&image);
+        painter.setFont(m_font);
+        painter.setPen(m_color);
+        const auto count = std::min(m_labelTexts.size(), m_labelRects.size());
+        for (int i = 0; i < count; ++i) {
+            painter.drawText(m_labelRects.at(i), Qt::AlignLeft | Qt::AlignTop | Qt::TextSingleLine, m_labelTexts.at(i));
+        }
+        painter.end();
+
+        textureNode->setTexture(window()->createTextureFromImage(image));
+        m_textureDirty = false;
+    }
+
+    textureNode->setRect(boundingRect());
+
+    return textureNode;
+}
+
 void AxisLabels::scheduleLayout()
 {
     if (!m_layoutScheduled) {
@@ -180,23 +329,72 @@ bool AxisLabels::isHorizontal()
     return m_direction == Direction::HorizontalLeftRight || m_direction == Direction::HorizontalRightLeft;
 }
 
+void AxisLabels::invalidateLabels()
+{
+    m_labelsValid = false;
+    updateLabels();
+}
+
 void AxisLabels::updateLabels()
 {
-    qDeleteAll(m_labels);
-    m_labels.clear();
+    const auto revision = m_source ? m_source->revision() : 0;
+    const auto delegateChanged = m_delegate != m_labelsDelegate;
+    if (m_labelsValid && !delegateChanged && revision == m_labelsRevision) {
+        return;
+    }
+
+    m_labelsDelegate = m_delegate;
+    m_labelsRevision = revision;
+    m_labelsValid = true;
+
+    const auto native = m_renderMode == RenderMode::Native;
+
+    QStringList labels;
+    if ((m_delegate || native) && m_source) {
+        for (int i = 0; i < m_source->itemCount(); ++i) {
+            labels << labelText(m_source->item(i));
+        }
+    }
 
-    if (!m_delegate || !m_source) {
+    // Creating delegates is expensive, so avoid it if the text of all labels
+    // remains the same.
+    if (!delegateChanged && labels == m_labelTexts) {
         return;
     }
 
-    for (int i = 0; i < m_source->itemCount(); ++i) {
-        auto label = m_source->item(i).toString();
+    m_labelTexts = labels;
+
+    if (native) {
+        scheduleLayout();
+        return;
+    }
+
+    // Instances of a different delegate cannot be reused.
+    if (delegateChanged) {
+        qDeleteAll(m_labels);
+        m_labels.clear();
+    }
+
+    while (m_labels.size() > labels.size()) {
+        delete m_labels.takeLast();
+    }
+
+    // Update the labels that already exist in place, only create new
+    // instances for labels that were added.
+    for (int i = 0; i < m_labels.size(); ++i) {
+        auto attached = static_cast<AxisLabelsAttached *>(qmlAttachedPropertiesObject<AxisLabels>(m_labels.at(i), true));
+        attached->setLabel(labels.at(i));
+    }
+
+    for (int i = m_labels.size(); i < labels.size(); ++i) {
+        const auto &label = labels.at(i);
 
         auto context = new QQmlContext(qmlContext(this));
         auto item = qobject_cast<QQuickItem *>(m_delegate->beginCreate(context));
         if (!item) {
             qWarning() << "Failed to create label instance for label" << label;
-            continue;
+            delete context;
+            break;
         }
 
         QObject::connect(item, &QQuickItem::xChanged, this, [this]() { scheduleLayout(); });
@@ -218,75 +416,123 @@ void AxisLabels::updateLabels()
     scheduleLayout();
 }
 
+QString AxisLabels::labelText(const QVariant &value) const
+{
+    if (m_formatter) {
+        return m_formatter->format(value);
+    }
+
+    if (m_renderMode == RenderMode::Native && m_decimals >= 0 && value.userType() != QMetaType::QString) {
+        bool ok = false;
+        auto number = value.toDouble(&ok);
+        if (ok) {
+            return QLocale().toString(number, 'f', m_decimals);
+        }
+    }
+
+    return value.toString();
+}
+
 void AxisLabels::layout()
 {
+    const auto native = m_renderMode == RenderMode::Native;
+
+    QVector<QSizeF> sizes;
+    if (native) {
+        QFontMetricsF metrics(m_font);
+        sizes.reserve(m_labelTexts.size());
+        for (const auto &text : qAsConst(m_labelTexts)) {
+            sizes << metrics.size(Qt::TextSingleLine, text);
+        }
+    } else {
+        sizes.reserve(m_labels.size());
+        for (auto label : qAsConst(m_labels)) {
+            sizes << QSizeF(label->width(), label->height());
+        }
+    }
+
     auto maxWidth = 0.0;
     auto totalWidth = 0.0;
     auto maxHeight = 0.0;
     auto totalHeight = 0.0;
 
-    for (auto label : qAsConst(m_labels)) {
-        maxWidth = std::max(maxWidth, label->width());
-        maxHeight = std::max(maxHeight, label->height());
-        totalWidth += label->width();
-        totalHeight += label->height();
+    for (const auto &size : qAsConst(sizes)) {
+        maxWidth = std::max(maxWidth, size.width());
+        maxHeight = std::max(maxHeight, size.height());
+        totalWidth += size.width();
+        totalHeight += size.height();
     }
 
     auto impWidth = isHorizontal() ? totalWidth : maxWidth;
     auto impHeight = isHorizontal() ? maxHeight : totalHeight;
 
-    if (qFuzzyCompare(impWidth, width()) && qFuzzyCompare(impHeight, height())) {
-        return;
-    }
-
     setImplicitWidth(impWidth);
     setImplicitHeight(impHeight);
 
-    auto spacing = (isHorizontal() ? width() : height()) / (m_labels.size() - 1);
-    auto i = 0;
+    // Labels are reused when their text changes, so they need to be
+    // positioned again even if the total size did not change.
+    auto length = isHorizontal() ? width() : height();
+    // Place labels for a chart axis at the ticks of that chart, so they line
+    // up with anything else using those ticks.
+    auto axisSource = qobject_cast<ChartAxisSource *>(m_source);
+    auto positions = axisSource ? axisSource->positions() : RangeGroup::tickPositions(1.0 / (sizes.size() - 1));
     auto layoutWidth = isHorizontal() ? 0.0 : width();
     auto layoutHeight = isHorizontal() ? height() : 0.0;
 
-    for (auto label : qAsConst(m_labels)) {
+    QVector<QRectF> rects;
+    rects.reserve(sizes.size());
+
+    for (int i = 0; i < sizes.size(); ++i) {
+        const auto &size = sizes.at(i);
         auto x = 0.0;
         auto y = 0.0;
 
         switch (m_direction) {
         case Direction::HorizontalLeftRight:
-            x = i * spacing;
+            x = positions.value(i) * length;
             break;
         case Direction::HorizontalRightLeft:
-            x = width() - i * spacing;
+            x = width() - positions.value(i) * length;
             break;
         case Direction::VerticalTopBottom:
-            y = i * spacing;
+            y = positions.value(i) * length;
             break;
         case Direction::VerticalBottomTop:
-            y = height() - i * spacing;
+            y = height() - positions.value(i) * length;
             break;
         }
 
         if (m_alignment & Qt::AlignHCenter) {
-            x += (layoutWidth - label->width()) / 2;
+            x += (layoutWidth - size.width()) / 2;
         } else if (m_alignment & Qt::AlignRight) {
-            x += layoutWidth - label->width();
+            x += layoutWidth - size.width();
         }
 
         if (m_alignment & Qt::AlignVCenter) {
-            y += (layoutHeight - label->height()) / 2;
+            y += (layoutHeight - size.height()) / 2;
         } else if (m_alignment & Qt::AlignBottom) {
-            y += layoutHeight - label->height();
+            y += layoutHeight - size.height();
         }
 
         if (m_constrainToBounds) {
             x = std::max(x, 0.0);
-            x = x + label->width() > width() ? width() - label->width() : x;
+            x = x + size.width() > width() ? width() - size.width() : x;
             y = std::max(y, 0.0);
-            y = y + label->height() > height() ? height() - label->height() : y;
+            y = y + size.height() > height() ? height() - size.height() : y;
         }
 
-        label->setX(x);
-        label->setY(y);
-        i++;
+        rects << QRectF{QPointF{x, y}, size};
+    }
+
+    if (native) {
+        m_labelRects = rects;
+        m_textureDirty = true;
+        update();
+        return;
+    }
+
+    for (int i = 0; i < m_labels.size(); ++i) {
+        m_labels.at(i)->setX(rects.at(i).x());
+        m_labels.at(i)->setY(rects.at(i).y());
     }
 }
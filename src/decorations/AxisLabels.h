@@ -24,10 +24,14 @@
 
 #include <memory>
 
+#include <QColor>
+#include <QFont>
+#include <QPointer>
 #include <QQuickItem>
 #include <Qt>
 
 class ChartDataSource;
+class ValueFormatter;
 
 class AxisLabels;
 
@@ -55,6 +59,9 @@ private:
 
 /**
  * An item that uses a delegate to place axis labels on a chart.
+ *
+ * For cases where a lot of labels are needed and no customization is
+ * required, labels can also be rendered directly, see renderMode.
  */
 class AxisLabels : public QQuickItem
 {
@@ -64,11 +71,43 @@ class AxisLabels : public QQuickItem
     Q_PROPERTY(ChartDataSource *source READ source WRITE setSource NOTIFY sourceChanged)
     Q_PROPERTY(Qt::Alignment alignment READ alignment WRITE setAlignment NOTIFY alignmentChanged)
     Q_PROPERTY(bool constrainToBounds READ constrainToBounds WRITE setConstrainToBounds NOTIFY constrainToBoundsChanged)
+    /**
+     * How to render the labels.
+     *
+     * Defaults to RenderMode.Delegate.
+     */
+    Q_PROPERTY(AxisLabels::RenderMode renderMode READ renderMode WRITE setRenderMode NOTIFY renderModeChanged)
+    /**
+     * The font to use for labels when renderMode is RenderMode.Native.
+     */
+    Q_PROPERTY(QFont font READ font WRITE setFont NOTIFY fontChanged)
+    /**
+     * The color to use for labels when renderMode is RenderMode.Native.
+     */
+    Q_PROPERTY(QColor color READ color WRITE setColor NOTIFY colorChanged)
+    /**
+     * The amount of decimals to display numbers with when renderMode is RenderMode.Native.
+     *
+     * If negative, the default, numbers are displayed as they are.
+     */
+    Q_PROPERTY(int decimals READ decimals WRITE setDecimals NOTIFY decimalsChanged)
+    /**
+     * The formatter used to convert values to label text.
+     *
+     * If set, this is used instead of decimals, for both render modes.
+     */
+    Q_PROPERTY(ValueFormatter *formatter READ formatter WRITE setFormatter NOTIFY formatterChanged)
 
 public:
     enum class Direction { HorizontalLeftRight, HorizontalRightLeft, VerticalTopBottom, VerticalBottomTop };
     Q_ENUM(Direction)
 
+    enum class RenderMode {
+        Delegate, ///< Create an instance of delegate for each label.
+        Native ///< Render all labels directly as a single item, using font, color and decimals.
+    };
+    Q_ENUM(RenderMode)
+
     explicit AxisLabels(QQuickItem *parent = nullptr);
 
     AxisLabels::Direction direction() const;
@@ -91,6 +130,26 @@ public:
     Q_SLOT void setConstrainToBounds(bool newConstrainToBounds);
     Q_SIGNAL void constrainToBoundsChanged();
 
+    AxisLabels::RenderMode renderMode() const;
+    Q_SLOT void setRenderMode(AxisLabels::RenderMode newRenderMode);
+    Q_SIGNAL void renderModeChanged();
+
+    QFont font() const;
+    Q_SLOT void setFont(const QFont &newFont);
+    Q_SIGNAL void fontChanged();
+
+    QColor color() const;
+    Q_SLOT void setColor(const QColor &newColor);
+    Q_SIGNAL void colorChanged();
+
+    int decimals() const;
+    Q_SLOT void setDecimals(int newDecimals);
+    Q_SIGNAL void decimalsChanged();
+
+    ValueFormatter *formatter() const;
+    Q_SLOT void setFormatter(ValueFormatter *newFormatter);
+    Q_SIGNAL void formatterChanged();
+
     static AxisLabelsAttached *qmlAttachedProperties(QObject *object)
     {
         return new AxisLabelsAttached(object);
@@ -98,11 +157,14 @@ public:
 
 protected:
     void geometryChanged(const QRectF &newGeometry, const QRectF &oldGeometry) override;
+    QSGNode *updatePaintNode(QSGNode *node, QQuickItem::UpdatePaintNodeData *data) override;
 
 private:
     void scheduleLayout();
     bool isHorizontal();
+    void invalidateLabels();
     void updateLabels();
+    QString labelText(const QVariant &value) const;
     void layout();
 
     Direction m_direction = Direction::HorizontalLeftRight;
@@ -110,8 +172,20 @@ private:
     ChartDataSource *m_source = nullptr;
     Qt::Alignment m_alignment = Qt::AlignHCenter | Qt::AlignVCenter;
     bool m_constrainToBounds = true;
+    RenderMode m_renderMode = RenderMode::Delegate;
+    QFont m_font;
+    QColor m_color = Qt::black;
+    int m_decimals = -1;
+    QPointer<ValueFormatter> m_formatter;
     QVector<QQuickItem *> m_labels;
+    QStringList m_labelTexts;
+    QQmlComponent *m_labelsDelegate = nullptr;
+    quint64 m_labelsRevision = 0;
+    bool m_labelsValid = false;
     bool m_layoutScheduled = false;
+    // Position of each label when rendering natively.
+    QVector<QRectF> m_labelRects;
+    bool m_textureDirty = true;
 };
 
 QML_DECLARE_TYPEINFO(AxisLabels, QML_HAS_ATTACHED_PROPERTIES)
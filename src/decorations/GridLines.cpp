@@ -21,6 +21,7 @@
 
 #include "GridLines.h"
 
+#include "RangeGroup.h"
 #include "XYChart.h"
 #include "scenegraph/LineGridNode.h"
 
@@ -186,9 +187,7 @@ LinePropertiesGroup *GridLines::minor() const
 QSGNode *GridLines::updatePaintNode(QSGNode *node, QQuickItem::UpdatePaintNodeData *)
 {
     if (!node) {
-        node = new QSGNode{};
-        node->appendChildNode(new LineGridNode{});
-        node->appendChildNode(new LineGridNode{});
+        node = new LineGridNode{};
     }
 
     if (m_chart) {
@@ -199,23 +198,41 @@ QSGNode *GridLines::updatePaintNode(QSGNode *node, QQuickItem::UpdatePaintNodeDa
         }
     }
 
-    updateLines(static_cast<LineGridNode *>(node->childAtIndex(0)), m_minor.get());
-    updateLines(static_cast<LineGridNode *>(node->childAtIndex(1)), m_major.get());
+    // Minor and major lines are rendered by the same node, with major lines
+    // on top. The node only rebuilds its geometry if the ticks or the size
+    // actually changed.
+    QVector<LineGridNode::LineSet> lineSets;
+    for (auto properties : {m_minor.get(), m_major.get()}) {
+        if (!properties->visible()) {
+            continue;
+        }
+
+        LineGridNode::LineSet lineSet;
+        lineSet.positions = ticks(properties);
+        lineSet.color = properties->color();
+        lineSet.lineWidth = properties->lineWidth();
+        lineSets << lineSet;
+    }
+
+    auto gridNode = static_cast<LineGridNode *>(node);
+    gridNode->setRect(boundingRect());
+    gridNode->setVertical(m_direction == Direction::Vertical);
+    gridNode->setLineSets(lineSets);
+    gridNode->commit();
 
-    return node;
+    return gridNode;
 }
 
-void GridLines::updateLines(LineGridNode *node, LinePropertiesGroup *properties)
+QVector<qreal> GridLines::ticks(LinePropertiesGroup *properties) const
 {
-    node->setVisible(properties->visible());
-    node->setRect(boundingRect());
-    node->setVertical(m_direction == Direction::Vertical);
-    node->setColor(properties->color());
-    node->setLineWidth(properties->lineWidth());
     if (properties->count() > 0) {
-        node->setSpacing(m_direction == Direction::Horizontal ? width() / (properties->count() + 1) : height() / (properties->count() + 1));
-    } else {
-        node->setSpacing(m_spacing * properties->frequency());
+        return RangeGroup::tickPositions(1.0 / (properties->count() + 1));
     }
-    node->update();
+
+    if (m_chart) {
+        return m_chart->ticks(m_direction == Direction::Horizontal ? Qt::Horizontal : Qt::Vertical, properties->frequency());
+    }
+
+    const auto length = m_direction == Direction::Horizontal ? width() : height();
+    return RangeGroup::tickPositions(length > 0.0 ? m_spacing * properties->frequency() / length : 0.0);
 }
@@ -27,7 +27,6 @@
 #include <QQuickItem>
 
 class GridLines;
-class LineGridNode;
 class XYChart;
 
 class LinePropertiesGroup : public QObject
@@ -106,7 +105,7 @@ public:
 
 private:
     QSGNode *updatePaintNode(QSGNode *node, QQuickItem::UpdatePaintNodeData *) override;
-    void updateLines(LineGridNode *node, LinePropertiesGroup *properties);
+    QVector<qreal> ticks(LinePropertiesGroup *properties) const;
 
     GridLines::Direction m_direction = Direction::Horizontal;
     XYChart *m_chart = nullptr;
@@ -22,6 +22,8 @@
 #include "LegendModel.h"
 
 #include "Chart.h"
+#include "PieChart.h"
+#include "ValueFormatter.h"
 #include "datasource/ChartDataSource.h"
 
 LegendModel::LegendModel(QObject *parent)
@@ -35,6 +37,7 @@ QHash<int, QByteArray> LegendModel::roleNames() const
         {NameRole, "name"},
         {ColorRole, "color"},
         {ValueRole, "value"},
+        {FormattedValueRole, "formattedValue"},
     };
 
     return names;
@@ -61,6 +64,8 @@ QVariant LegendModel::data(const QModelIndex &index, int role) const
         return m_items.at(index.row()).color;
     case ValueRole:
         return m_items.at(index.row()).value;
+    case FormattedValueRole:
+        return m_items.at(index.row()).formattedValue;
     }
 
     return QVariant{};
@@ -77,12 +82,12 @@ void LegendModel::setChart(Chart *newChart)
         return;
     }
 
-    if (m_chart) {
-        for (const auto &connection : qAsConst(m_connections)) {
-            disconnect(connection);
-        }
-        m_connections.clear();
+    // Stop following the previous chart right away, connections to the new
+    // chart are made when updating.
+    for (const auto &connection : qAsConst(m_connections)) {
+        disconnect(connection);
     }
+    m_connections.clear();
 
     m_chart = newChart;
     queueUpdate();
@@ -105,6 +110,32 @@ void LegendModel::setSourceIndex(int index)
     Q_EMIT sourceIndexChanged();
 }
 
+ValueFormatter *LegendModel::formatter() const
+{
+    return m_formatter;
+}
+
+void LegendModel::setFormatter(ValueFormatter *newFormatter)
+{
+    if (newFormatter == m_formatter) {
+        return;
+    }
+
+    if (m_formatter) {
+        m_formatter->disconnect(this);
+    }
+
+    m_formatter = newFormatter;
+
+    if (m_formatter) {
+        connect(m_formatter, &ValueFormatter::formatChanged, this, &LegendModel::queueUpdate);
+        connect(m_formatter, &QObject::destroyed, this, &LegendModel::queueUpdate);
+    }
+
+    queueUpdate();
+    Q_EMIT formatterChanged();
+}
+
 void LegendModel::queueUpdate()
 {
     if (!m_updateQueued) {
@@ -117,88 +148,184 @@ void LegendModel::update()
 {
     m_updateQueued = false;
 
-    if (!m_chart)
-        return;
-
-    beginResetModel();
-    m_items.clear();
+    updateConnections();
 
-    ChartDataSource *colorSource = m_chart->colorSource();
-    ChartDataSource *nameSource = m_chart->nameSource();
-    ChartDataSource *valueSource = nullptr;
+    std::vector<LegendItem> items;
 
-    m_connections.push_back(connect(m_chart, &Chart::colorSourceChanged, this, &LegendModel::queueUpdate, Qt::UniqueConnection));
-    m_connections.push_back(connect(m_chart, &Chart::nameSourceChanged, this, &LegendModel::queueUpdate, Qt::UniqueConnection));
+    if (m_chart && (m_chart->colorSource() || m_chart->nameSource())) {
+        const auto itemCount = countItems();
+        items.reserve(std::max(itemCount, 0));
+        for (int i = 0; i < itemCount; ++i) {
+            items.push_back(createItem(i));
+        }
+    }
 
-    auto sources = m_chart->valueSources();
-    int itemCount = countItems();
+    m_revisions = m_chart ? m_chart->sourceRevisions() : QVector<quint64>{};
 
-    std::transform(sources.cbegin(), sources.cend(), std::back_inserter(m_connections), [this](ChartDataSource *source) {
-        return connect(source, &ChartDataSource::dataChanged, this, &LegendModel::updateData, Qt::UniqueConnection);
-    });
+    applyItems(std::move(items));
+}
 
-    m_connections.push_back(connect(m_chart, &Chart::valueSourcesChanged, this, &LegendModel::queueUpdate, Qt::UniqueConnection));
+void LegendModel::updateConnections()
+{
+    for (const auto &connection : qAsConst(m_connections)) {
+        disconnect(connection);
+    }
+    m_connections.clear();
 
-    if ((!colorSource && !nameSource) || itemCount <= 0) {
-        endResetModel();
+    if (!m_chart) {
         return;
     }
 
-    if (colorSource)
-        m_connections.push_back(connect(colorSource, &ChartDataSource::dataChanged, this, &LegendModel::updateData, Qt::UniqueConnection));
+    m_connections.push_back(connect(m_chart, &Chart::colorSourceChanged, this, &LegendModel::queueUpdate));
+    m_connections.push_back(connect(m_chart, &Chart::nameSourceChanged, this, &LegendModel::queueUpdate));
+    m_connections.push_back(connect(m_chart, &Chart::valueSourcesChanged, this, &LegendModel::queueUpdate));
 
-    if (nameSource)
-        m_connections.push_back(connect(nameSource, &ChartDataSource::dataChanged, this, &LegendModel::updateData, Qt::UniqueConnection));
+    // Follow the chart rather than the value sources, so the legend updates
+    // at the same rate as the chart.
+    m_connections.push_back(connect(m_chart, &Chart::dataUpdated, this, &LegendModel::updateData));
 
-    for (int i = 0; i < itemCount; ++i) {
-        LegendItem item;
-        item.name = nameSource ? nameSource->item(i).toString() : QString();
-        item.color = colorSource ? colorSource->item(i).value<QColor>() : QColor();
-
-        if (m_sourceIndex < 0) {
-            item.value = m_chart->valueSources().at(i)->item(0);
-        } else {
-            item.value = valueSource ? valueSource->item(i) : QVariant{};
-        }
+    if (auto pie = qobject_cast<PieChart *>(m_chart)) {
+        m_connections.push_back(connect(pie, &PieChart::slicesChanged, this, &LegendModel::queueUpdate));
+        m_connections.push_back(connect(pie, &PieChart::maximumSlicesChanged, this, &LegendModel::queueUpdate));
+        m_connections.push_back(connect(pie, &PieChart::otherNameChanged, this, &LegendModel::queueUpdate));
+        m_connections.push_back(connect(pie, &PieChart::otherColorChanged, this, &LegendModel::queueUpdate));
+    }
 
-        m_items.push_back(item);
+    if (auto colorSource = m_chart->colorSource()) {
+        m_connections.push_back(connect(colorSource, &ChartDataSource::dataChanged, this, &LegendModel::updateData));
     }
 
-    endResetModel();
+    if (auto nameSource = m_chart->nameSource()) {
+        m_connections.push_back(connect(nameSource, &ChartDataSource::dataChanged, this, &LegendModel::updateData));
+    }
 }
 
 void LegendModel::updateData()
 {
-    ChartDataSource *colorSource = m_chart->colorSource();
-    ChartDataSource *nameSource = m_chart->nameSource();
-    ChartDataSource *valueSource = nullptr;
+    if (!m_chart || (!m_chart->colorSource() && !m_chart->nameSource())) {
+        return;
+    }
 
-    auto itemCount = countItems();
+    auto revisions = m_chart->sourceRevisions();
+    if (revisions == m_revisions) {
+        return;
+    }
 
-    if (itemCount != int(m_items.size())) {
-        // Number of items changed, so trigger a full update
+    if (revisions.size() != m_revisions.size()) {
         queueUpdate();
         return;
     }
 
-    std::for_each(m_items.begin(), m_items.end(), [&, i = 0](LegendItem &item) mutable {
-        item.name = nameSource ? nameSource->item(i).toString() : QString();
-        item.color = colorSource ? colorSource->item(i).value<QColor>() : QColor();
+    // The name and color source revisions are the last two entries.
+    const auto namesChanged = revisions.at(revisions.size() - 2) != m_revisions.at(revisions.size() - 2);
+    const auto colorsChanged = revisions.last() != m_revisions.last();
+    m_revisions = revisions;
 
-        if (m_sourceIndex < 0) {
-            item.value = m_chart->valueSources().at(i)->item(0);
-        } else {
-            item.value = valueSource ? valueSource->item(i) : QVariant{};
+    const auto itemCount = countItems();
+
+    std::vector<LegendItem> items;
+    items.reserve(std::max(itemCount, 0));
+
+    // Slices of a pie chart can move around, so they always need to be
+    // created again. Otherwise, only read what actually changed.
+    if (slicedChart() || itemCount != int(m_items.size())) {
+        for (int i = 0; i < itemCount; ++i) {
+            items.push_back(createItem(i));
+        }
+    } else {
+        for (int i = 0; i < itemCount; ++i) {
+            auto item = m_items.at(i);
+            if (namesChanged) {
+                item.name = itemName(i);
+            }
+            if (colorsChanged) {
+                item.color = itemColor(i);
+            }
+            auto value = itemValue(i);
+            if (value != item.value) {
+                item.value = value;
+                item.formattedValue = formatValue(value);
+            }
+            items.push_back(item);
+        }
+    }
+
+    applyItems(std::move(items));
+}
+
+void LegendModel::applyItems(std::vector<LegendItem> &&items)
+{
+    const auto oldCount = int(m_items.size());
+    const auto newCount = int(items.size());
+    const auto commonCount = std::min(oldCount, newCount);
+
+    // Update rows that exist both before and after, keeping track of which
+    // roles changed so they can be reported with a single signal.
+    QVector<int> changedRoles;
+    int firstChanged = -1;
+    int lastChanged = -1;
+
+    for (int i = 0; i < commonCount; ++i) {
+        auto &current = m_items.at(i);
+        const auto &next = items.at(i);
+
+        auto changed = false;
+        if (current.name != next.name) {
+            current.name = next.name;
+            changed = true;
+            if (!changedRoles.contains(NameRole)) {
+                changedRoles << NameRole;
+            }
+        }
+        if (current.color != next.color) {
+            current.color = next.color;
+            changed = true;
+            if (!changedRoles.contains(ColorRole)) {
+                changedRoles << ColorRole;
+            }
+        }
+        if (current.value != next.value) {
+            current.value = next.value;
+            changed = true;
+            if (!changedRoles.contains(ValueRole)) {
+                changedRoles << ValueRole;
+            }
+        }
+        if (current.formattedValue != next.formattedValue) {
+            current.formattedValue = next.formattedValue;
+            changed = true;
+            if (!changedRoles.contains(FormattedValueRole)) {
+                changedRoles << FormattedValueRole;
+            }
         }
 
-        i++;
-    });
+        if (changed) {
+            firstChanged = firstChanged < 0 ? i : firstChanged;
+            lastChanged = i;
+        }
+    }
 
-    Q_EMIT dataChanged(index(0, 0), index(itemCount - 1, 0), {NameRole, ColorRole, ValueRole});
+    if (firstChanged >= 0) {
+        Q_EMIT dataChanged(index(firstChanged, 0), index(lastChanged, 0), changedRoles);
+    }
+
+    if (newCount < oldCount) {
+        beginRemoveRows(QModelIndex{}, newCount, oldCount - 1);
+        m_items.erase(m_items.begin() + newCount, m_items.end());
+        endRemoveRows();
+    } else if (newCount > oldCount) {
+        beginInsertRows(QModelIndex{}, oldCount, newCount - 1);
+        std::move(items.begin() + oldCount, items.end(), std::back_inserter(m_items));
+        endInsertRows();
+    }
 }
 
 int LegendModel::countItems()
 {
+    if (auto pie = slicedChart()) {
+        return pie->sliceIndices(std::max(m_sourceIndex, 0)).size();
+    }
+
     auto sources = m_chart->valueSources();
     int itemCount = 0;
 
@@ -220,3 +347,77 @@ int LegendModel::countItems()
 
     return itemCount;
 }
+
+LegendItem LegendModel::createItem(int row)
+{
+    LegendItem item;
+
+    if (auto pie = slicedChart()) {
+        ChartDataSource *colorSource = m_chart->colorSource();
+        ChartDataSource *nameSource = m_chart->nameSource();
+
+        auto sourceIndex = std::max(m_sourceIndex, 0);
+        auto index = pie->sliceIndices(sourceIndex).value(row, -1);
+
+        if (index < 0) {
+            item.name = pie->otherName();
+            item.color = pie->otherColor();
+            item.value = pie->otherValue(sourceIndex);
+        } else {
+            item.name = nameSource ? nameSource->item(index).toString() : QString();
+            item.color = colorSource ? colorSource->item(index).value<QColor>() : QColor();
+            auto source = pie->valueSources().value(sourceIndex);
+            item.value = source ? source->item(index) : QVariant{};
+        }
+
+        item.formattedValue = formatValue(item.value);
+        return item;
+    }
+
+    item.name = itemName(row);
+    item.color = itemColor(row);
+    item.value = itemValue(row);
+    item.formattedValue = formatValue(item.value);
+
+    return item;
+}
+
+QString LegendModel::itemName(int row) const
+{
+    auto nameSource = m_chart->nameSource();
+    return nameSource ? nameSource->item(row).toString() : QString();
+}
+
+QColor LegendModel::itemColor(int row) const
+{
+    auto colorSource = m_chart->colorSource();
+    return colorSource ? colorSource->item(row).value<QColor>() : QColor();
+}
+
+QVariant LegendModel::itemValue(int row) const
+{
+    if (m_sourceIndex < 0) {
+        auto source = m_chart->valueSources().value(row);
+        return source ? source->item(0) : QVariant{};
+    }
+
+    auto valueSource = m_chart->valueSources().value(m_sourceIndex);
+    return valueSource ? valueSource->item(row) : QVariant{};
+}
+
+QString LegendModel::formatValue(const QVariant &value) const
+{
+    return m_formatter ? m_formatter->format(value) : value.toString();
+}
+
+PieChart *LegendModel::slicedChart() const
+{
+    // A pie chart that combines items into an "other" slice displays something
+    // different from its name and color sources, so use its slice mapping.
+    auto pie = qobject_cast<PieChart *>(m_chart);
+    if (!pie || pie->maximumSlices() <= 0 || pie->indexingMode() != Chart::IndexSourceValues || pie->valueSources().isEmpty()) {
+        return nullptr;
+    }
+
+    return pie;
+}
@@ -26,15 +26,19 @@
 
 #include <QAbstractListModel>
 #include <QColor>
+#include <QPointer>
 
 class Chart;
 class ChartDataSource;
+class PieChart;
+class ValueFormatter;
 
 struct LegendItem
 {
     QString name;
     QColor color;
     QVariant value;
+    QString formattedValue;
 };
 
 /**
@@ -45,9 +49,16 @@ class LegendModel : public QAbstractListModel
     Q_OBJECT
     Q_PROPERTY(Chart *chart READ chart WRITE setChart NOTIFY chartChanged)
     Q_PROPERTY(int sourceIndex READ sourceIndex WRITE setSourceIndex NOTIFY sourceIndexChanged)
+    /**
+     * The formatter used to provide the formattedValue role.
+     *
+     * If not set, formattedValue contains the value converted to a string.
+     */
+    Q_PROPERTY(ValueFormatter *formatter READ formatter WRITE setFormatter NOTIFY formatterChanged)
 
 public:
-    enum Roles { NameRole = Qt::UserRole, ColorRole, ValueRole };
+    enum Roles { NameRole = Qt::UserRole, ColorRole, ValueRole, FormattedValueRole };
+    Q_ENUM(Roles)
 
     enum SourceIndex { UseSourceCount = -2 };
     Q_ENUM(SourceIndex)
@@ -66,17 +77,32 @@ public:
     void setSourceIndex(int index);
     Q_SIGNAL void sourceIndexChanged();
 
+    ValueFormatter *formatter() const;
+    void setFormatter(ValueFormatter *newFormatter);
+    Q_SIGNAL void formatterChanged();
+
 private:
     void queueUpdate();
     void update();
+    void updateConnections();
     void updateData();
+    void applyItems(std::vector<LegendItem> &&items);
     int countItems();
+    LegendItem createItem(int row);
+    QString itemName(int row) const;
+    QColor itemColor(int row) const;
+    QVariant itemValue(int row) const;
+    QString formatValue(const QVariant &value) const;
+    PieChart *slicedChart() const;
 
     Chart *m_chart = nullptr;
     int m_sourceIndex = UseSourceCount;
+    QPointer<ValueFormatter> m_formatter;
     bool m_updateQueued = false;
     std::vector<QMetaObject::Connection> m_connections;
     std::vector<LegendItem> m_items;
+    // Source revisions the items were created from.
+    QVector<quint64> m_revisions;
 };
 
 #endif // LEGENDMODEL_H
@@ -0,0 +1,133 @@
+/*
+ * This file is part of Quick Charts.
+ * Copyright 2019 Arjen Hiemstra <ahiemstra@heimr.nl>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License or (at your option) version 3 or any later version
+ * accepted by the membership of KDE e.V. (or its successor approved
+ * by the membership of KDE e.V.), which shall act as a proxy
+ * defined in Section 14 of version 3 of the license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "LegendSortFilterModel.h"
+
+#include <cmath>
+
+#include "LegendModel.h"
+
+LegendSortFilterModel::LegendSortFilterModel(QObject *parent)
+    : QSortFilterProxyModel(parent)
+{
+    setDynamicSortFilter(true);
+}
+
+LegendSortFilterModel::SortMode LegendSortFilterModel::sortMode() const
+{
+    return m_sortMode;
+}
+
+void LegendSortFilterModel::setSortMode(SortMode newSortMode)
+{
+    if (newSortMode == m_sortMode) {
+        return;
+    }
+
+    m_sortMode = newSortMode;
+    updateSorting();
+    Q_EMIT sortModeChanged();
+}
+
+Qt::SortOrder LegendSortFilterModel::sortOrder() const
+{
+    return m_sortOrder;
+}
+
+void LegendSortFilterModel::setSortOrder(Qt::SortOrder newSortOrder)
+{
+    if (newSortOrder == m_sortOrder) {
+        return;
+    }
+
+    m_sortOrder = newSortOrder;
+    updateSorting();
+    Q_EMIT sortOrderChanged();
+}
+
+QString LegendSortFilterModel::filterText() const
+{
+    return m_filterText;
+}
+
+void LegendSortFilterModel::setFilterText(const QString &newFilterText)
+{
+    if (newFilterText == m_filterText) {
+        return;
+    }
+
+    m_filterText = newFilterText;
+    invalidateFilter();
+    Q_EMIT filterTextChanged();
+}
+
+bool LegendSortFilterModel::filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const
+{
+    if (m_filterText.isEmpty()) {
+        return true;
+    }
+
+    auto name = sourceModel()->index(sourceRow, 0, sourceParent).data(LegendModel::NameRole).toString();
+    return name.contains(m_filterText, Qt::CaseInsensitive);
+}
+
+bool LegendSortFilterModel::lessThan(const QModelIndex &left, const QModelIndex &right) const
+{
+    if (m_sortMode == SortByValue) {
+        auto leftValue = left.data(LegendModel::ValueRole);
+        auto rightValue = right.data(LegendModel::ValueRole);
+
+        bool leftOk = false;
+        bool rightOk = false;
+        auto leftNumber = leftValue.toDouble(&leftOk);
+        auto rightNumber = rightValue.toDouble(&rightOk);
+        // NaN does not compare to anything, so treat it like any other value
+        // that is not a number.
+        leftOk = leftOk && !std::isnan(leftNumber);
+        rightOk = rightOk && !std::isnan(rightNumber);
+        if (leftOk && rightOk) {
+            return leftNumber < rightNumber;
+        }
+
+        // Mixing numeric and text comparisons would not be a consistent
+        // ordering, so all numbers sort before anything that is not a number.
+        if (leftOk != rightOk) {
+            return leftOk;
+        }
+
+        return leftValue.toString().localeAwareCompare(rightValue.toString()) < 0;
+    }
+
+    auto leftName = left.data(LegendModel::NameRole).toString();
+    auto rightName = right.data(LegendModel::NameRole).toString();
+    return leftName.localeAwareCompare(rightName) < 0;
+}
+
+void LegendSortFilterModel::updateSorting()
+{
+    if (m_sortMode == Unsorted) {
+        // A negative column restores the order of the source model.
+        sort(-1);
+        return;
+    }
+
+    sort(0, m_sortOrder);
+}
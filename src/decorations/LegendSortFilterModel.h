@@ -0,0 +1,85 @@
+/*
+ * This file is part of Quick Charts.
+ * Copyright 2019 Arjen Hiemstra <ahiemstra@heimr.nl>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License or (at your option) version 3 or any later version
+ * accepted by the membership of KDE e.V. (or its successor approved
+ * by the membership of KDE e.V.), which shall act as a proxy
+ * defined in Section 14 of version 3 of the license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LEGENDSORTFILTERMODEL_H
+#define LEGENDSORTFILTERMODEL_H
+
+#include <QSortFilterProxyModel>
+
+/**
+ * A proxy model that sorts and filters the items of a LegendModel.
+ *
+ * Sorting and filtering is done incrementally when the source model changes,
+ * so it can be used with legends that have a lot of items.
+ */
+class LegendSortFilterModel : public QSortFilterProxyModel
+{
+    Q_OBJECT
+    /**
+     * How to sort items. Defaults to Unsorted.
+     */
+    Q_PROPERTY(SortMode sortMode READ sortMode WRITE setSortMode NOTIFY sortModeChanged)
+    /**
+     * The order to sort items in. Defaults to ascending order.
+     */
+    Q_PROPERTY(Qt::SortOrder sortOrder READ sortOrder WRITE setSortOrder NOTIFY sortOrderChanged)
+    /**
+     * Only include items whose name contains this text, ignoring case.
+     *
+     * If empty, the default, all items are included.
+     */
+    Q_PROPERTY(QString filterText READ filterText WRITE setFilterText NOTIFY filterTextChanged)
+
+public:
+    enum SortMode {
+        Unsorted, ///< Keep items in the order of the source model.
+        SortByName, ///< Sort items by their name.
+        SortByValue ///< Sort items by their value.
+    };
+    Q_ENUM(SortMode)
+
+    explicit LegendSortFilterModel(QObject *parent = nullptr);
+
+    SortMode sortMode() const;
+    void setSortMode(SortMode newSortMode);
+    Q_SIGNAL void sortModeChanged();
+
+    Qt::SortOrder sortOrder() const;
+    void setSortOrder(Qt::SortOrder newSortOrder);
+    Q_SIGNAL void sortOrderChanged();
+
+    QString filterText() const;
+    void setFilterText(const QString &newFilterText);
+    Q_SIGNAL void filterTextChanged();
+
+protected:
+    bool filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const override;
+    bool lessThan(const QModelIndex &left, const QModelIndex &right) const override;
+
+private:
+    void updateSorting();
+
+    SortMode m_sortMode = Unsorted;
+    Qt::SortOrder m_sortOrder = Qt::AscendingOrder;
+    QString m_filterText;
+};
+
+#endif // LEGENDSORTFILTERMODEL_H
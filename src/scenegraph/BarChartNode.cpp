@@ -51,11 +51,16 @@ void BarChartNode::setRect(const QRectF &rect)
         return;
 
     m_rect = rect;
+    m_dirty = true;
 }
 
 void BarChartNode::setValues(const QVector<QPair<QVector2D, QColor>> &values)
 {
+    if (values == m_values)
+        return;
+
     m_values = values;
+    m_dirty = true;
 }
 
 void BarChartNode::setBarWidth(qreal width)
@@ -64,13 +69,16 @@ void BarChartNode::setBarWidth(qreal width)
         return;
 
     m_barWidth = width;
+    m_dirty = true;
 }
 
-void BarChartNode::update()
+void BarChartNode::commit()
 {
-    if (!m_rect.isValid() || m_values.isEmpty())
+    if (!m_dirty || !m_rect.isValid() || m_values.isEmpty())
         return;
 
+    m_dirty = false;
+
     auto itemCount = m_values.count();
 
     if (itemCount <= 0)
@@ -43,7 +43,11 @@ public:
     void setRect(const QRectF &rect);
     void setValues(const QVector<QPair<QVector2D, QColor>> &values);
     void setBarWidth(qreal width);
-    void update();
+
+    /**
+     * Rebuild the geometry if any of the properties changed since the last call.
+     */
+    void commit();
 
 private:
     void bar(QSGGeometry::ColoredPoint2D *vertices, quint16 *indices, int &index, const QRectF &bar, const QColor &color);
@@ -51,6 +55,7 @@ private:
     QRectF m_rect;
     QVector<QPair<QVector2D, QColor>> m_values;
     qreal m_barWidth = 0.0;
+    bool m_dirty = false;
     QSGGeometry *m_geometry = nullptr;
 };
 
@@ -41,54 +41,22 @@ QSGMaterialShader *LineChartMaterial::createShader() const
     return new LineChartShader();
 }
 
-QColor LineChartMaterial::lineColor() const
+int LineChartMaterial::compare(const QSGMaterial *other) const
 {
-    return m_lineColor;
+    // There is no per-material state, so all instances are interchangeable.
+    Q_UNUSED(other);
+    return 0;
 }
 
-QColor LineChartMaterial::fillColor() const
+const QSGGeometry::AttributeSet &LineChartMaterial::attributes()
 {
-    return m_fillColor;
-}
-
-float LineChartMaterial::lineWidth() const
-{
-    return m_lineWidth;
-}
-
-QVector<QVector2D> LineChartMaterial::points() const
-{
-    return m_points;
-}
-
-float LineChartMaterial::aspect() const
-{
-    return m_aspect;
-}
-
-void LineChartMaterial::setLineColor(const QColor &color)
-{
-    m_lineColor = color;
-}
-
-void LineChartMaterial::setFillColor(const QColor &color)
-{
-    m_fillColor = color;
-}
-
-void LineChartMaterial::setLineWidth(float width)
-{
-    m_lineWidth = width;
-}
-
-void LineChartMaterial::setPoints(const QVector<QVector2D> &points)
-{
-    m_points = points;
-}
-
-void LineChartMaterial::setAspect(float aspect)
-{
-    m_aspect = aspect;
+    static QSGGeometry::Attribute data[] = {
+        QSGGeometry::Attribute::createWithAttributeType(0, 2, QSGGeometry::FloatType, QSGGeometry::PositionAttribute),
+        QSGGeometry::Attribute::createWithAttributeType(1, 4, QSGGeometry::UnsignedByteType, QSGGeometry::ColorAttribute),
+        QSGGeometry::Attribute::createWithAttributeType(2, 2, QSGGeometry::FloatType, QSGGeometry::TexCoordAttribute),
+    };
+    static QSGGeometry::AttributeSet attributes = {3, sizeof(Vertex), data};
+    return attributes;
 }
 
 LineChartShader::LineChartShader()
@@ -102,7 +70,7 @@ LineChartShader::~LineChartShader()
 
 const char *const *LineChartShader::attributeNames() const
 {
-    static char const *const names[] = {"in_vertex", "in_uv", nullptr};
+    static char const *const names[] = {"in_vertex", "in_color", "in_edge", nullptr};
     return names;
 }
 
@@ -111,28 +79,15 @@ void LineChartShader::initialize()
     QSGMaterialShader::initialize();
     m_matrixLocation = program()->uniformLocation("matrix");
     m_opacityLocation = program()->uniformLocation("opacity");
-    m_lineColorLocation = program()->uniformLocation("lineColor");
-    m_fillColorLocation = program()->uniformLocation("fillColor");
-    m_lineWidthLocation = program()->uniformLocation("lineWidth");
-    m_pointsLocation = program()->uniformLocation("points");
-    m_pointCountLocation = program()->uniformLocation("pointCount");
-    m_aspectLocation = program()->uniformLocation("aspect");
 }
 
 void LineChartShader::updateState(const QSGMaterialShader::RenderState &state, QSGMaterial *newMaterial, QSGMaterial *oldMaterial)
 {
+    Q_UNUSED(newMaterial);
+    Q_UNUSED(oldMaterial);
+
     if (state.isMatrixDirty())
         program()->setUniformValue(m_matrixLocation, state.combinedMatrix());
     if (state.isOpacityDirty())
         program()->setUniformValue(m_opacityLocation, state.opacity());
-
-    if (!oldMaterial || newMaterial->compare(oldMaterial) != 0) {
-        LineChartMaterial *material = static_cast<LineChartMaterial *>(newMaterial);
-        program()->setUniformValue(m_lineColorLocation, material->lineColor());
-        program()->setUniformValue(m_fillColorLocation, material->fillColor());
-        program()->setUniformValue(m_lineWidthLocation, material->lineWidth());
-        program()->setUniformValue(m_aspectLocation, material->aspect());
-        program()->setUniformValue(m_pointCountLocation, material->points().size());
-        program()->setUniformValueArray(m_pointsLocation, material->points().constData(), material->points().size());
-    }
 }
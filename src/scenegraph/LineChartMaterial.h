@@ -23,38 +23,63 @@
 #define LINECHARTMATERIAL_H
 
 #include <QColor>
+#include <QSGGeometry>
 #include <QSGMaterial>
 #include <QSGMaterialShader>
+#include <QVector2D>
 
 #include "SDFShader.h"
 
+/**
+ * A material for rendering lines and the area below them.
+ *
+ * All data needed for rendering is stored per vertex, so this material has no
+ * state of its own. This allows the renderer to batch all geometry using it
+ * into a minimal number of draw calls.
+ */
 class LineChartMaterial : public QSGMaterial
 {
 public:
+    /**
+     * The layout of a vertex used with this material.
+     */
+    struct Vertex {
+        float x;
+        float y;
+        unsigned char r;
+        unsigned char g;
+        unsigned char b;
+        unsigned char a;
+        // Distance from the center of the line, in pixels.
+        float edge;
+        // Half the width of the line, in pixels.
+        float halfWidth;
+
+        void set(const QVector2D &position, const QColor &color, float newEdge, float newHalfWidth)
+        {
+            x = position.x();
+            y = position.y();
+            auto alpha = color.alphaF();
+            r = uchar(color.red() * alpha);
+            g = uchar(color.green() * alpha);
+            b = uchar(color.blue() * alpha);
+            a = uchar(color.alpha());
+            edge = newEdge;
+            halfWidth = newHalfWidth;
+        }
+    };
+
     LineChartMaterial();
     ~LineChartMaterial();
 
     QSGMaterialType *type() const override;
     QSGMaterialShader *createShader() const override;
+    int compare(const QSGMaterial *other) const override;
 
-    QColor lineColor() const;
-    QColor fillColor() const;
-    float lineWidth() const;
-    float aspect() const;
-    QVector<QVector2D> points() const;
-
-    void setLineColor(const QColor &color);
-    void setFillColor(const QColor &color);
-    void setLineWidth(float width);
-    void setPoints(const QVector<QVector2D> &points);
-    void setAspect(float aspect);
-
-private:
-    QColor m_lineColor;
-    QColor m_fillColor;
-    float m_lineWidth = 0.0;
-    float m_aspect = 1.0;
-    QVector<QVector2D> m_points;
+    /**
+     * The attribute set to use for geometry rendered with this material.
+     */
+    static const QSGGeometry::AttributeSet &attributes();
 };
 
 class LineChartShader : public SDFShader
@@ -71,12 +96,6 @@ public:
 private:
     int m_matrixLocation = 0;
     int m_opacityLocation = 0;
-    int m_lineColorLocation = 0;
-    int m_fillColorLocation = 0;
-    int m_lineWidthLocation = 0;
-    int m_pointsLocation = 0;
-    int m_pointCountLocation = 0;
-    int m_aspectLocation = 0;
 };
 
 #endif // LINECHARTMATERIAL_H
@@ -24,16 +24,19 @@
 #include <QColor>
 #include <QtMath>
 
-#include "LineChartMaterial.h"
 #include "LineSegmentNode.h"
 
-static const int MaxPointsInSegment = 100;
-
-qreal calculateNormalizedLineWidth(qreal pixelWidth, const QRectF &rect)
-{
-    qreal min = 0.6 / std::max(rect.width(), rect.height());
-    return std::max(min, (pixelWidth - 1.0) / (std::min(rect.width(), rect.height()) * 4.0));
-}
+// The maximum amount of points of a single series that is added to a segment
+// in one piece. Longer series are split so segments can be filled evenly.
+//
+// Points arrive here already reduced to at most a few per pixel column, see
+// LineChartPreparation, and lines are rendered with per-vertex coverage, so
+// the cost per fragment does not depend on the amount of points. Segments are
+// therefore only split to keep their vertices addressable.
+static const int MaxPointsInLine = 1000;
+// The maximum amount of vertices in a single segment, so that all vertices can
+// be addressed with 16-bit indices.
+static const int MaxVerticesInSegment = 65535;
 
 LineChartNode::LineChartNode()
 {
@@ -41,6 +44,7 @@ LineChartNode::LineChartNode()
 
 LineChartNode::~LineChartNode()
 {
+    qDeleteAll(m_unusedSegments);
 }
 
 void LineChartNode::setRect(const QRectF &rect)
@@ -49,8 +53,7 @@ void LineChartNode::setRect(const QRectF &rect)
         return;
 
     m_rect = rect;
-    m_aspect = m_rect.height() / m_rect.width();
-    updatePoints();
+    m_dirty = true;
 }
 
 void LineChartNode::setLineWidth(float width)
@@ -59,77 +62,115 @@ void LineChartNode::setLineWidth(float width)
         return;
 
     m_lineWidth = width;
-    std::for_each(m_segments.cbegin(), m_segments.cend(), [this](LineSegmentNode *node) {
-        node->setLineWidth(calculateNormalizedLineWidth(m_lineWidth, m_rect));
-    });
+    m_dirty = true;
 }
 
-void LineChartNode::setLineColor(const QColor &color)
+void LineChartNode::setSeriesCount(int count)
 {
-    if (m_lineColor == color)
+    if (count == m_series.size())
         return;
 
-    m_lineColor = color;
-    std::for_each(m_segments.cbegin(), m_segments.cend(), [color](LineSegmentNode *node) { node->setLineColor(color); });
+    m_series.resize(count);
+    m_dirty = true;
 }
 
-void LineChartNode::setFillColor(const QColor &color)
+void LineChartNode::setSeries(int index, const QVector<QVector2D> &values, const QColor &lineColor, const QColor &fillColor)
 {
-    if (m_fillColor == color)
+    if (index < 0 || index >= m_series.size())
+        return;
+
+    auto &series = m_series[index];
+    if (series.values == values && series.lineColor == lineColor && series.fillColor == fillColor)
         return;
 
-    m_fillColor = color;
-    std::for_each(m_segments.cbegin(), m_segments.cend(), [color](LineSegmentNode *node) { node->setFillColor(color); });
+    series.values = values;
+    series.lineColor = lineColor;
+    series.fillColor = fillColor;
+    m_dirty = true;
 }
 
-void LineChartNode::setValues(const QVector<QVector2D> &values)
+void LineChartNode::commit()
 {
-    m_values = values;
-    updatePoints();
+    if (m_dirty) {
+        updateSegments();
+    }
+
+    std::for_each(m_segments.cbegin(), m_segments.cend(), [](LineSegmentNode *node) { node->commit(); });
+
+    m_dirty = false;
 }
 
-void LineChartNode::updatePoints()
+void LineChartNode::updateSegments()
 {
-    if (m_values.isEmpty())
+    if (m_rect.width() <= 0.0) {
+        updateSegmentCount(0);
         return;
+    }
 
-    auto segmentCount = qCeil(qreal(m_values.count()) / MaxPointsInSegment);
-    if (segmentCount != m_segments.count()) {
-        removeAllChildNodes();
-        m_segments.clear();
-
-        for (int i = 0; i < segmentCount; ++i) {
-            auto node = new LineSegmentNode{};
-            m_segments << node;
-            appendChildNode(node);
+    QVector<QVector<LineSegmentNode::Line>> segments;
+    QVector<LineSegmentNode::Line> currentSegment;
+    auto currentVertexCount = 0;
+
+    // Series are added in reverse order, so that the first series is rendered on top.
+    for (auto itr = m_series.rbegin(); itr != m_series.rend(); ++itr) {
+        if (itr->values.isEmpty())
+            continue;
+
+        const auto &values = itr->values;
+        const auto lastIndex = values.count() - 1;
+        const auto pieceCount = std::max(1, qCeil(qreal(lastIndex) / MaxPointsInLine));
+
+        for (int i = 0; i < pieceCount; ++i) {
+            // Pieces share their boundary points, so the lines connect.
+            auto first = int(qint64(lastIndex) * i / pieceCount);
+            auto last = int(qint64(lastIndex) * (i + 1) / pieceCount);
+
+            LineSegmentNode::Line line;
+            line.values = values;
+            line.first = first;
+            line.count = last - first + 1;
+            line.lineColor = itr->lineColor;
+            line.fillColor = itr->fillColor;
+
+            auto vertexCount = LineSegmentNode::vertexCount(line);
+            if (currentVertexCount + vertexCount > MaxVerticesInSegment && !currentSegment.isEmpty()) {
+                segments << currentSegment;
+                currentSegment.clear();
+                currentVertexCount = 0;
+            }
+
+            currentSegment << line;
+            currentVertexCount += vertexCount;
         }
     }
 
-    auto currentX = m_rect.left();
-    auto pointStart = 0;
-    auto pointsPerSegment = m_values.count() / m_segments.count();
-
-    for (auto segment : qAsConst(m_segments)) {
-        auto segmentPoints = m_values.mid(pointStart, pointsPerSegment);
-        pointStart += pointsPerSegment;
+    if (!currentSegment.isEmpty()) {
+        segments << currentSegment;
+    }
 
-        if (pointStart < m_values.count()) {
-            segmentPoints.append(m_values[pointStart]);
-        }
+    updateSegmentCount(segments.size());
 
-        auto segmentWidth = segmentPoints.last().x() - currentX;
-        auto rect = QRectF(currentX, m_rect.top(), segmentWidth, m_rect.height());
+    for (int i = 0; i < segments.size(); ++i) {
+        auto segment = m_segments.at(i);
+        segment->setRect(m_rect);
+        segment->setLineWidth(m_lineWidth);
+        segment->setLines(segments.at(i));
+    }
+}
 
-        segment->setRect(rect);
-        segment->setAspect(segmentWidth / m_rect.width(), m_aspect);
-        segment->setLineWidth(calculateNormalizedLineWidth(m_lineWidth, m_rect));
-        segment->setLineColor(m_lineColor);
-        segment->setFillColor(m_fillColor);
-        segment->setValues(segmentPoints);
-        segment->setFarLeft(m_values.at(std::max(0, pointStart - pointsPerSegment - 1)));
-        segment->setFarRight(m_values.at(std::min(m_values.count() - 1, pointStart + 1)));
-        segment->updatePoints();
+void LineChartNode::updateSegmentCount(int count)
+{
+    // Only add or remove the difference, keeping removed segments around so
+    // changes in the amount of data do not keep recreating nodes.
+    while (m_segments.count() < count) {
+        auto node = m_unusedSegments.isEmpty() ? new LineSegmentNode{} : m_unusedSegments.takeLast();
+        m_segments << node;
+        appendChildNode(node);
+    }
 
-        currentX += segmentWidth;
+    while (m_segments.count() > count) {
+        auto node = m_segments.takeLast();
+        removeChildNode(node);
+        m_unusedSegments << node;
     }
 }
@@ -24,13 +24,18 @@
 
 #include <QColor>
 #include <QSGNode>
+#include <QVector2D>
 
 class QRectF;
-class LineChartMaterial;
 class LineSegmentNode;
 
 /**
- * @todo write docs
+ * A node rendering all lines of a line chart.
+ *
+ * Series are expected to be prepared for rendering already, see
+ * LineChartPreparation. All series are tessellated into a small number of
+ * shared geometry nodes, so the amount of nodes and draw calls does not
+ * depend on the number of series.
  */
 class LineChartNode : public QSGNode
 {
@@ -44,20 +49,30 @@ public:
 
     void setRect(const QRectF &rect);
     void setLineWidth(float width);
-    void setLineColor(const QColor &color);
-    void setFillColor(const QColor &color);
-    void setValues(const QVector<QVector2D> &values);
+    void setSeriesCount(int count);
+    void setSeries(int index, const QVector<QVector2D> &values, const QColor &lineColor, const QColor &fillColor);
+
+    /**
+     * Apply all changes made through the setters to this node and its segments.
+     */
+    void commit();
 
 private:
-    void updatePoints();
+    struct Series {
+        QVector<QVector2D> values;
+        QColor lineColor;
+        QColor fillColor;
+    };
+
+    void updateSegments();
+    void updateSegmentCount(int count);
 
     QRectF m_rect;
     float m_lineWidth = 0.0;
-    float m_aspect = 1.0;
-    QColor m_lineColor;
-    QColor m_fillColor;
-    QVector<QVector2D> m_values;
+    QVector<Series> m_series;
     QVector<LineSegmentNode *> m_segments;
+    QVector<LineSegmentNode *> m_unusedSegments;
+    bool m_dirty = false;
 };
 
 #endif // LINECHARTNODE_H
@@ -21,20 +21,20 @@
 
 #include "LineGridNode.h"
 
-#include <cmath>
+#include <limits>
 
-#include <QSGFlatColorMaterial>
+#include <QSGVertexColorMaterial>
+
+// Each line is a quad, limit the amount so indices fit in 16 bits.
+static const int MaximumLines = std::numeric_limits<quint16>::max() / 4;
 
 LineGridNode::LineGridNode()
 {
-    m_geometry = new QSGGeometry{QSGGeometry::defaultAttributes_Point2D(), 0};
-    m_geometry->setDrawingMode(QSGGeometry::DrawLines);
-    m_geometry->setLineWidth(m_lineWidth);
+    m_geometry = new QSGGeometry{QSGGeometry::defaultAttributes_ColoredPoint2D(), 0, 0};
+    m_geometry->setDrawingMode(QSGGeometry::DrawTriangles);
     setGeometry(m_geometry);
 
-    m_material = new QSGFlatColorMaterial{};
-    m_material->setColor(QColor(255, 0, 0, 255));
-    setMaterial(m_material);
+    setMaterial(new QSGVertexColorMaterial{});
 
     setFlags(QSGNode::OwnsGeometry | QSGNode::OwnsMaterial);
 }
@@ -43,21 +43,13 @@ LineGridNode::~LineGridNode()
 {
 }
 
-void LineGridNode::setVisible(bool visible)
-{
-    if (visible == m_visible)
-        return;
-
-    m_visible = visible;
-    markDirty(QSGNode::DirtySubtreeBlocked);
-}
-
 void LineGridNode::setVertical(bool vertical)
 {
     if (vertical == m_vertical)
         return;
 
     m_vertical = vertical;
+    m_geometryDirty = true;
 }
 
 void LineGridNode::setRect(const QRectF &rect)
@@ -66,100 +58,83 @@ void LineGridNode::setRect(const QRectF &rect)
         return;
 
     m_rect = rect;
+    m_geometryDirty = true;
 }
 
-void LineGridNode::setColor(const QColor &color)
-{
-    if (color == m_material->color())
-        return;
-
-    m_material->setColor(color);
-    markDirty(QSGNode::DirtyMaterial);
-}
-
-void LineGridNode::setSpacing(float spacing)
+void LineGridNode::setLineSets(const QVector<LineSet> &lineSets)
 {
-    if (qFuzzyCompare(spacing, m_spacing))
+    if (lineSets == m_lineSets)
         return;
 
-    m_spacing = spacing;
-}
-
-void LineGridNode::setLineWidth(float lineWidth)
-{
-    if (qFuzzyCompare(lineWidth, m_lineWidth)) {
-        return;
-    }
-
-    m_lineWidth = lineWidth;
-    m_geometry->setLineWidth(lineWidth);
-    markDirty(QSGNode::DirtyGeometry);
-}
-
-bool LineGridNode::isSubtreeBlocked() const
-{
-    return !m_visible;
+    m_lineSets = lineSets;
+    m_geometryDirty = true;
 }
 
-void LineGridNode::update()
+void LineGridNode::commit()
 {
-    if (!m_rect.isValid())
+    if (!m_geometryDirty)
         return;
 
-    int totalVertices = 0;
-    if (!m_vertical) {
-        totalVertices = std::floor(m_rect.width() / std::ceil(m_spacing)) * 2 + 4;
-    } else {
-        totalVertices = std::floor(m_rect.height() / std::ceil(m_spacing)) * 2 + 4;
-    }
+    m_geometryDirty = false;
 
-    if (totalVertices < 4) {
-        return;
+    int lineCount = 0;
+    if (m_rect.isValid()) {
+        for (const auto &lineSet : qAsConst(m_lineSets)) {
+            lineCount += lineSet.positions.size();
+        }
     }
+    lineCount = std::min(lineCount, MaximumLines);
 
-    if (totalVertices != m_geometry->vertexCount()) {
-        m_geometry->allocate(totalVertices, totalVertices);
-    }
+    m_geometry->allocate(lineCount * 4, lineCount * 6);
 
-    auto vertices = m_geometry->vertexDataAsPoint2D();
+    auto vertices = m_geometry->vertexDataAsColoredPoint2D();
     auto indices = m_geometry->indexDataAsUShort();
 
-    if (!vertices || !indices) {
-        return;
-    }
-
-    int index = 0;
-    if (m_vertical) {
-        line(vertices, indices, index, m_rect.left(), m_rect.top(), m_rect.right(), m_rect.top());
-
-        auto y = m_spacing;
-        for (auto i = 0; i < (totalVertices - 4) / 2; ++i) {
-            line(vertices, indices, index, m_rect.left(), y, m_rect.right(), y);
-            y += m_spacing;
-        }
-
-        line(vertices, indices, index, m_rect.left(), m_rect.bottom(), m_rect.right(), m_rect.bottom());
-    } else {
-        line(vertices, indices, index, m_rect.left(), m_rect.top(), m_rect.left(), m_rect.bottom());
-
-        auto x = m_spacing;
-        for (auto i = 0; i < (totalVertices - 4) / 2; ++i) {
-            line(vertices, indices, index, x, m_rect.top(), x, m_rect.bottom());
-            x += m_spacing;
+    int line = 0;
+    for (const auto &lineSet : qAsConst(m_lineSets)) {
+        // The vertex color material expects premultiplied colors.
+        const auto color = lineSet.color;
+        const auto alpha = color.alphaF();
+        const uchar r = color.redF() * alpha * 255;
+        const uchar g = color.greenF() * alpha * 255;
+        const uchar b = color.blueF() * alpha * 255;
+        const uchar a = alpha * 255;
+
+        const auto halfWidth = lineSet.lineWidth / 2.0;
+
+        for (auto position : lineSet.positions) {
+            if (line >= lineCount) {
+                break;
+            }
+
+            QRectF lineRect;
+            if (m_vertical) {
+                auto y = m_rect.top() + position * m_rect.height();
+                lineRect = QRectF{QPointF{m_rect.left(), y - halfWidth}, QPointF{m_rect.right(), y + halfWidth}};
+            } else {
+                auto x = m_rect.left() + position * m_rect.width();
+                lineRect = QRectF{QPointF{x - halfWidth, m_rect.top()}, QPointF{x + halfWidth, m_rect.bottom()}};
+            }
+
+            const auto vertex = line * 4;
+            vertices[vertex].set(lineRect.left(), lineRect.top(), r, g, b, a);
+            vertices[vertex + 1].set(lineRect.right(), lineRect.top(), r, g, b, a);
+            vertices[vertex + 2].set(lineRect.left(), lineRect.bottom(), r, g, b, a);
+            vertices[vertex + 3].set(lineRect.right(), lineRect.bottom(), r, g, b, a);
+
+            const auto index = line * 6;
+            indices[index] = vertex;
+            indices[index + 1] = vertex + 1;
+            indices[index + 2] = vertex + 2;
+            indices[index + 3] = vertex + 1;
+            indices[index + 4] = vertex + 3;
+            indices[index + 5] = vertex + 2;
+
+            line++;
         }
-
-        line(vertices, indices, index, m_rect.right(), m_rect.top(), m_rect.right(), m_rect.bottom());
     }
 
     m_geometry->markVertexDataDirty();
     m_geometry->markIndexDataDirty();
     markDirty(QSGNode::DirtyGeometry);
 }
-
-void LineGridNode::line(QSGGeometry::Point2D *vertices, quint16 *indices, int &index, qreal fromX, qreal fromY, qreal toX, qreal toY)
-{
-    indices[index] = index;
-    vertices[index++].set(fromX, fromY);
-    indices[index] = index;
-    vertices[index++].set(toX, toY);
-}
@@ -24,40 +24,52 @@
 
 #include <QColor>
 #include <QSGGeometryNode>
-
-class QSGFlatColorMaterial;
+#include <QVector>
 
 /**
- * @todo write docs
+ * A node that renders sets of grid lines in a single draw call.
+ *
+ * Each set of lines has its own color and width. Lines are positioned using
+ * fractions of the size of the node's rectangle, so the geometry only needs
+ * to be rebuilt when the positions or the rectangle change.
  */
 class LineGridNode : public QSGGeometryNode
 {
 public:
+    struct LineSet {
+        QVector<qreal> positions;
+        QColor color;
+        float lineWidth = 1.0;
+
+        bool operator==(const LineSet &other) const
+        {
+            return positions == other.positions && color == other.color && qFuzzyCompare(lineWidth, other.lineWidth);
+        }
+    };
+
     LineGridNode();
     ~LineGridNode();
 
-    void setVisible(bool visible);
     void setVertical(bool vertical);
     void setRect(const QRectF &rect);
-    void setColor(const QColor &color);
-    void setSpacing(float spacing);
-    void setLineWidth(float lineWidth);
+    /**
+     * Set the lines to render. Later sets are rendered on top of earlier sets.
+     */
+    void setLineSets(const QVector<LineSet> &lineSets);
 
-    bool isSubtreeBlocked() const override;
-
-    void update();
+    /**
+     * Apply all changes made through the setters, rebuilding the lines only if needed.
+     */
+    void commit();
 
 private:
-    void line(QSGGeometry::Point2D *vertices, quint16 *indices, int &index, qreal fromX, qreal fromY, qreal toX, qreal toY);
-
     QSGGeometry *m_geometry = nullptr;
-    QSGFlatColorMaterial *m_material = nullptr;
 
-    bool m_visible = true;
     bool m_vertical = false;
     QRectF m_rect;
-    float m_spacing = 1.0;
-    float m_lineWidth = 1.0;
+    QVector<LineSet> m_lineSets;
+
+    bool m_geometryDirty = false;
 };
 
 #endif // LINEGRIDNODE_H
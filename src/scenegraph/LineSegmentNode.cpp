@@ -21,24 +21,39 @@
 
 #include "LineSegmentNode.h"
 
+#include <algorithm>
+
 #include <QColor>
 #include <QSGGeometry>
 
 #include "LineChartMaterial.h"
 
-LineSegmentNode::LineSegmentNode()
-    : LineSegmentNode(QRectF{})
+// Half width used for the area below the line, large enough that it is never
+// faded out by the line's anti-aliasing. This is passed to a mediump varying,
+// which on OpenGL ES is only guaranteed to hold values up to 2^14.
+static const float FillHalfWidth = 1e4;
+// The maximum factor a line is widened by at sharp corners.
+static const float MaxMiterScale = 2.0;
+
+// The unit normal of the line from "from" to "to", or a null vector if both
+// points are the same.
+static QVector2D lineNormal(const QVector2D &from, const QVector2D &to)
 {
+    auto direction = to - from;
+    if (qFuzzyIsNull(direction.lengthSquared()))
+        return QVector2D{};
+
+    direction.normalize();
+    return QVector2D{-direction.y(), direction.x()};
 }
 
-LineSegmentNode::LineSegmentNode(const QRectF &rect)
+LineSegmentNode::LineSegmentNode()
 {
-    m_geometry = new QSGGeometry{QSGGeometry::defaultAttributes_TexturedPoint2D(), 4};
-    QSGGeometry::updateTexturedRectGeometry(m_geometry, rect, QRectF{0, 0, 1, 1});
+    m_geometry = new QSGGeometry{LineChartMaterial::attributes(), 0, 0, QSGGeometry::UnsignedShortType};
+    m_geometry->setDrawingMode(QSGGeometry::DrawTriangles);
     setGeometry(m_geometry);
 
-    m_material = new LineChartMaterial{};
-    setMaterial(m_material);
+    setMaterial(new LineChartMaterial{});
 
     setFlags(QSGNode::OwnsGeometry | QSGNode::OwnsMaterial);
 }
@@ -53,24 +68,7 @@ void LineSegmentNode::setRect(const QRectF &rect)
         return;
 
     m_rect = rect;
-    QSGGeometry::updateTexturedRectGeometry(m_geometry, m_rect, QRectF{0.0, 0, m_xAspect, 1});
-    markDirty(QSGNode::DirtyGeometry);
-
-    updatePoints();
-}
-
-void LineSegmentNode::setAspect(float xAspect, float yAspect)
-{
-    if (qFuzzyCompare(xAspect, m_xAspect) && qFuzzyCompare(yAspect, m_yAspect))
-        return;
-
-    m_yAspect = yAspect;
-    m_material->setAspect(m_yAspect);
-    markDirty(QSGNode::DirtyMaterial);
-
-    m_xAspect = xAspect;
-    QSGGeometry::updateTexturedRectGeometry(m_geometry, m_rect, QRectF{0.0, 0, m_xAspect, 1});
-    markDirty(QSGNode::DirtyGeometry);
+    m_dirty = true;
 }
 
 void LineSegmentNode::setLineWidth(float width)
@@ -79,76 +77,139 @@ void LineSegmentNode::setLineWidth(float width)
         return;
 
     m_lineWidth = width;
-    m_material->setLineWidth(m_lineWidth);
-    markDirty(QSGNode::DirtyMaterial);
+    m_dirty = true;
 }
 
-void LineSegmentNode::setLineColor(const QColor &color)
+void LineSegmentNode::setLines(const QVector<Line> &lines)
 {
-    if (m_material->lineColor() == color)
-        return;
-
-    m_material->setLineColor(color);
-    markDirty(QSGNode::DirtyMaterial);
+    m_lines = lines;
+    m_dirty = true;
 }
 
-void LineSegmentNode::setFillColor(const QColor &color)
+void LineSegmentNode::commit()
 {
-    if (m_material->fillColor() == color)
-        return;
-
-    m_material->setFillColor(color);
-    markDirty(QSGNode::DirtyMaterial);
-}
+    if (m_dirty) {
+        updateGeometry();
+        // The lines are no longer needed, release them so their buffers can be
+        // reused without detaching.
+        m_lines.clear();
+    }
 
-void LineSegmentNode::setValues(const QVector<QVector2D> &values)
-{
-    m_values = values;
+    m_dirty = false;
 }
 
-void LineSegmentNode::setFarLeft(const QVector2D &value)
+int LineSegmentNode::vertexCount(const Line &line)
 {
-    m_farLeft = value;
-}
+    // Every point results in two vertices for the line and, when filled, two
+    // for the area below it.
+    if (line.count < 2)
+        return 0;
 
-void LineSegmentNode::setFarRight(const QVector2D &value)
-{
-    m_farRight = value;
+    return line.count * (line.fillColor.alpha() > 0 ? 4 : 2);
 }
 
-void LineSegmentNode::updatePoints()
+void LineSegmentNode::updateGeometry()
 {
-    if (m_values.isEmpty())
-        return;
+    // Each pair of vertices is connected to the next pair with a quad.
+    auto vertexCount = 0;
+    auto indexCount = 0;
+    for (const auto &line : qAsConst(m_lines)) {
+        auto count = LineSegmentNode::vertexCount(line);
+        vertexCount += count;
+        indexCount += count > 0 ? (count / 2 - (line.fillColor.alpha() > 0 ? 2 : 1)) * 6 : 0;
+    }
 
-    QVector<QVector2D> points;
-    points.reserve(m_values.size() + 6);
+    if (m_geometry->vertexCount() != vertexCount || m_geometry->indexCount() != indexCount) {
+        m_geometry->allocate(vertexCount, indexCount);
+    }
 
-    points << QVector2D{0.0, -0.5};
-    points << QVector2D{-0.5, -0.5};
+    auto vertices = static_cast<LineChartMaterial::Vertex *>(m_geometry->vertexData());
+    auto indices = m_geometry->indexDataAsUShort();
+    auto vertexIndex = 0;
+    auto index = 0;
 
-    if (!m_farLeft.isNull()) {
-        points << QVector2D(-0.5, m_farLeft.y() * m_yAspect);
-        points << QVector2D(((m_farLeft.x() - m_rect.left()) / m_rect.width()) * m_xAspect, m_farLeft.y() * m_yAspect);
-    } else {
-        points << QVector2D(-0.5, m_values[0].y() * m_yAspect);
+    for (const auto &line : qAsConst(m_lines)) {
+        addLine(line, vertices, indices, vertexIndex, index);
     }
 
-    for (auto value : qAsConst(m_values)) {
-        auto x = ((value.x() - m_rect.left()) / m_rect.width()) * m_xAspect;
-        points << QVector2D(x, value.y() * m_yAspect);
-    }
+    markDirty(QSGNode::DirtyGeometry);
+}
+
+void LineSegmentNode::addLine(const Line &line, LineChartMaterial::Vertex *vertices, quint16 *indices, int &vertexIndex, int &index)
+{
+    const auto values = line.values.constData() + line.first;
+    const auto pointCount = line.count;
+    if (pointCount < 2)
+        return;
 
-    if (!m_farRight.isNull()) {
-        points << QVector2D(((m_farRight.x() - m_rect.left()) / m_rect.width()) * m_xAspect, m_farRight.y() * m_yAspect);
-        points << QVector2D(1.5, m_farRight.y() * m_yAspect);
-    } else {
-        points << QVector2D(1.5, points.last().y());
+    auto addQuad = [&indices, &index](int topLeft) {
+        indices[index++] = topLeft;
+        indices[index++] = topLeft + 1;
+        indices[index++] = topLeft + 2;
+        indices[index++] = topLeft + 2;
+        indices[index++] = topLeft + 1;
+        indices[index++] = topLeft + 3;
+    };
+
+    if (line.fillColor.alpha() > 0) {
+        const auto bottom = float(m_rect.bottom());
+        for (int i = 0; i < pointCount; ++i) {
+            auto point = toPixels(values[i]);
+            vertices[vertexIndex].set(point, line.fillColor, 0.0, FillHalfWidth);
+            vertices[vertexIndex + 1].set(QVector2D{point.x(), bottom}, line.fillColor, 0.0, FillHalfWidth);
+
+            if (i < pointCount - 1) {
+                addQuad(vertexIndex);
+            }
+
+            vertexIndex += 2;
+        }
     }
 
-    points << QVector2D{1.5, -0.5};
-    points << QVector2D{0.0, -0.5};
+    // The line is extended by a pixel on each side to leave room for
+    // anti-aliasing, which is done by the shader based on the edge distance.
+    const auto halfWidth = m_lineWidth / 2.0f;
+    const auto edge = halfWidth + 1.0f;
+
+    auto previous = toPixels(line.first > 0 ? values[-1] : values[0]);
+    auto current = toPixels(values[0]);
+    const auto hasNext = line.first + pointCount < line.values.size();
+
+    for (int i = 0; i < pointCount; ++i) {
+        QVector2D next;
+        if (i < pointCount - 1 || hasNext) {
+            next = toPixels(values[i + 1]);
+        } else {
+            next = current;
+        }
+
+        // Offset along the average of the normals of both adjacent lines, so
+        // consecutive lines meet in a mitered join.
+        auto before = lineNormal(previous, current);
+        auto after = lineNormal(current, next);
+        auto normal = (before + after).normalized();
+        auto scale = 1.0f;
+        if (normal.isNull()) {
+            normal = before.isNull() ? after : before;
+        } else if (!before.isNull() && !after.isNull()) {
+            scale = 1.0f / std::max(QVector2D::dotProduct(normal, after), 1.0f / MaxMiterScale);
+        }
+
+        auto offset = normal * edge * scale;
+        vertices[vertexIndex].set(current + offset, line.lineColor, edge, halfWidth);
+        vertices[vertexIndex + 1].set(current - offset, line.lineColor, -edge, halfWidth);
+
+        if (i < pointCount - 1) {
+            addQuad(vertexIndex);
+        }
+
+        vertexIndex += 2;
+        previous = current;
+        current = next;
+    }
+}
 
-    m_material->setPoints(points);
-    markDirty(QSGNode::DirtyMaterial);
+QVector2D LineSegmentNode::toPixels(const QVector2D &value) const
+{
+    return QVector2D(value.x(), m_rect.bottom() - qBound(0.0f, value.y(), 1.0f) * m_rect.height());
 }
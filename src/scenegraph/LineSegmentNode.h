@@ -26,21 +26,37 @@
 #include <QSGGeometryNode>
 #include <QVector2D>
 
+#include "LineChartMaterial.h"
+
 class QRectF;
-class LineChartMaterial;
 
 /**
- * @todo write docs
+ * A geometry node containing one or more lines.
+ *
+ * All lines of a segment are tessellated into a single geometry, using the
+ * colors of each line as vertex data.
  */
 class LineSegmentNode : public QSGGeometryNode
 {
 public:
-    LineSegmentNode();
+    /**
+     * A line, or part of a line, to render in this segment.
+     */
+    struct Line {
+        // The points of the entire line. Only count points starting at first
+        // are rendered, the points around those connect to the rest of the
+        // line. This allows pieces of a line to share the same buffer.
+        QVector<QVector2D> values;
+        int first = 0;
+        int count = 0;
+        QColor lineColor;
+        QColor fillColor;
+    };
 
     /**
      * Default constructor
      */
-    explicit LineSegmentNode(const QRectF &rect);
+    LineSegmentNode();
 
     /**
      * Destructor
@@ -48,26 +64,29 @@ public:
     ~LineSegmentNode();
 
     void setRect(const QRectF &rect);
-    void setAspect(float xAspect, float yAspect);
     void setLineWidth(float width);
-    void setLineColor(const QColor &color);
-    void setFillColor(const QColor &color);
-    void setValues(const QVector<QVector2D> &values);
-    void setFarLeft(const QVector2D &value);
-    void setFarRight(const QVector2D &value);
+    void setLines(const QVector<Line> &lines);
 
-    void updatePoints();
+    /**
+     * Apply all changes made through the setters.
+     */
+    void commit();
+
+    /**
+     * The amount of vertices that will be used to render a line.
+     */
+    static int vertexCount(const Line &line);
 
 private:
+    void updateGeometry();
+    void addLine(const Line &line, LineChartMaterial::Vertex *vertices, quint16 *indices, int &vertexIndex, int &index);
+    QVector2D toPixels(const QVector2D &value) const;
+
     QRectF m_rect;
     float m_lineWidth = 0.0;
-    float m_xAspect = 1.0;
-    float m_yAspect = 1.0;
-    QVector2D m_farLeft;
-    QVector2D m_farRight;
-    QVector<QVector2D> m_values;
+    QVector<Line> m_lines;
+    bool m_dirty = false;
     QSGGeometry *m_geometry = nullptr;
-    LineChartMaterial *m_material = nullptr;
 };
 
 #endif // LINESEGMENTNODE_H
@@ -46,19 +46,19 @@ QVector2D PieChartMaterial::aspectRatio() const
     return m_aspectRatio;
 }
 
-float PieChartMaterial::innerRadius() const
+QColor PieChartMaterial::backgroundColor() const
 {
-    return m_innerRadius;
+    return m_backgroundColor;
 }
 
-float PieChartMaterial::outerRadius() const
+QVector<QVector2D> PieChartMaterial::rings() const
 {
-    return m_outerRadius;
+    return m_rings;
 }
 
-QColor PieChartMaterial::backgroundColor() const
+QVector<int> PieChartMaterial::ringSegments() const
 {
-    return m_backgroundColor;
+    return m_ringSegments;
 }
 
 QVector<QVector2D> PieChartMaterial::triangles() const
@@ -86,19 +86,19 @@ void PieChartMaterial::setAspectRatio(const QVector2D &aspect)
     m_aspectRatio = aspect;
 }
 
-void PieChartMaterial::setInnerRadius(float radius)
+void PieChartMaterial::setBackgroundColor(const QColor &color)
 {
-    m_innerRadius = radius;
+    m_backgroundColor = color;
 }
 
-void PieChartMaterial::setOuterRadius(float radius)
+void PieChartMaterial::setRings(const QVector<QVector2D> &rings)
 {
-    m_outerRadius = radius;
+    m_rings = rings;
 }
 
-void PieChartMaterial::setBackgroundColor(const QColor &color)
+void PieChartMaterial::setRingSegments(const QVector<int> &ringSegments)
 {
-    m_backgroundColor = color;
+    m_ringSegments = ringSegments;
 }
 
 void PieChartMaterial::setTriangles(const QVector<QVector2D> &triangles)
@@ -141,14 +141,14 @@ void PieChartShader::initialize()
     QSGMaterialShader::initialize();
     m_matrixLocation = program()->uniformLocation("matrix");
     m_opacityLocation = program()->uniformLocation("opacity");
-    m_innerRadiusLocation = program()->uniformLocation("innerRadius");
-    m_outerRadiusLocation = program()->uniformLocation("outerRadius");
     m_aspectLocation = program()->uniformLocation("aspect");
     m_backgroundColorLocation = program()->uniformLocation("backgroundColor");
+    m_ringsLocation = program()->uniformLocation("rings");
+    m_ringSegmentsLocation = program()->uniformLocation("ringSegments");
+    m_ringCountLocation = program()->uniformLocation("ringCount");
     m_trianglesLocation = program()->uniformLocation("triangles");
     m_colorsLocation = program()->uniformLocation("colors");
     m_segmentsLocation = program()->uniformLocation("segments");
-    m_segmentCountLocation = program()->uniformLocation("segmentCount");
     m_smoothEndsLocation = program()->uniformLocation("smoothEnds");
 }
 
@@ -161,14 +161,14 @@ void PieChartShader::updateState(const QSGMaterialShader::RenderState &state, QS
 
     if (!oldMaterial || newMaterial->compare(oldMaterial) != 0) {
         PieChartMaterial *material = static_cast<PieChartMaterial *>(newMaterial);
-        program()->setUniformValue(m_innerRadiusLocation, material->innerRadius());
-        program()->setUniformValue(m_outerRadiusLocation, material->outerRadius());
         program()->setUniformValue(m_aspectLocation, material->aspectRatio());
         program()->setUniformValue(m_backgroundColorLocation, material->backgroundColor());
+        program()->setUniformValueArray(m_ringsLocation, material->rings().constData(), material->rings().size());
+        program()->setUniformValueArray(m_ringSegmentsLocation, material->ringSegments().constData(), material->ringSegments().size());
+        program()->setUniformValue(m_ringCountLocation, material->rings().size());
         program()->setUniformValueArray(m_trianglesLocation, material->triangles().constData(), material->triangles().size());
         program()->setUniformValueArray(m_colorsLocation, material->colors().constData(), material->colors().size());
         program()->setUniformValueArray(m_segmentsLocation, material->segments().constData(), material->segments().size());
-        program()->setUniformValue(m_segmentCountLocation, material->segments().size());
         program()->setUniformValue(m_smoothEndsLocation, material->smoothEnds());
     }
 }
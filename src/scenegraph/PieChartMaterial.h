@@ -38,32 +38,41 @@ public:
     QSGMaterialShader *createShader() const override;
 
     QVector2D aspectRatio() const;
-    float innerRadius() const;
-    float outerRadius() const;
     QColor backgroundColor() const;
     bool smoothEnds() const;
 
+    QVector<QVector2D> rings() const;
+    QVector<int> ringSegments() const;
+
     QVector<QVector2D> triangles() const;
     QVector<QVector4D> colors() const;
     QVector<int> segments() const;
 
     void setAspectRatio(const QVector2D &aspect);
-    void setInnerRadius(float radius);
-    void setOuterRadius(float radius);
     void setBackgroundColor(const QColor &color);
     void setSmoothEnds(bool smooth);
 
+    /**
+     * Set the inner (x) and outer (y) radius of each ring.
+     */
+    void setRings(const QVector<QVector2D> &rings);
+    /**
+     * Set how many entries of segments and colors belong to each ring.
+     */
+    void setRingSegments(const QVector<int> &ringSegments);
+
     void setTriangles(const QVector<QVector2D> &triangles);
     void setColors(const QVector<QVector4D> &colors);
     void setSegments(const QVector<int> &segments);
 
 private:
     QVector2D m_aspectRatio;
-    float m_innerRadius = 0.0f;
-    float m_outerRadius = 0.0f;
     QColor m_backgroundColor;
     bool m_smoothEnds = false;
 
+    QVector<QVector2D> m_rings;
+    QVector<int> m_ringSegments;
+
     QVector<QVector2D> m_triangles;
     QVector<QVector4D> m_colors;
     QVector<int> m_segments;
@@ -83,14 +92,14 @@ public:
 private:
     int m_matrixLocation = 0;
     int m_opacityLocation = 0;
-    int m_innerRadiusLocation = 0;
-    int m_outerRadiusLocation = 0;
     int m_aspectLocation = 0;
     int m_backgroundColorLocation = 0;
+    int m_ringsLocation = 0;
+    int m_ringSegmentsLocation = 0;
+    int m_ringCountLocation = 0;
     int m_trianglesLocation = 0;
     int m_colorsLocation = 0;
     int m_segmentsLocation = 0;
-    int m_segmentCountLocation = 0;
     int m_smoothEndsLocation = 0;
 };
 
@@ -24,7 +24,9 @@
 #include <algorithm>
 
 #include <QColor>
+#include <QDebug>
 #include <QSGGeometry>
+#include <QSGGeometryNode>
 #include <cmath>
 
 #include "PieChartMaterial.h"
@@ -32,6 +34,11 @@
 static const qreal pi = std::acos(-1.0);
 static const qreal sectionSize = pi * 0.5;
 
+// These need to match MAX_SEGMENTS and MAX_RINGS in the pie chart shaders,
+// they limit the amount of segments and rings rendered by a single quad.
+static const int MaximumSegments = 100;
+static const int MaximumRings = 16;
+
 inline QVector4D colorToVec4(const QColor &color)
 {
     return QVector4D{float(color.redF()), float(color.greenF()), float(color.blueF()), float(color.alphaF())};
@@ -55,15 +62,9 @@ PieChartNode::PieChartNode()
 }
 
 PieChartNode::PieChartNode(const QRectF &rect)
+    : m_rect(rect)
 {
-    m_geometry = new QSGGeometry{QSGGeometry::defaultAttributes_TexturedPoint2D(), 4};
-    QSGGeometry::updateTexturedRectGeometry(m_geometry, rect, QRectF{0, 0, 1, 1});
-    setGeometry(m_geometry);
-
-    m_material = new PieChartMaterial{};
-    setMaterial(m_material);
-
-    setFlags(QSGNode::OwnsGeometry | QSGNode::OwnsMaterial);
+    m_geometryDirty = true;
 }
 
 PieChartNode::~PieChartNode()
@@ -76,60 +77,58 @@ void PieChartNode::setRect(const QRectF &rect)
         return;
 
     m_rect = rect;
-    QSGGeometry::updateTexturedRectGeometry(m_geometry, m_rect, QRectF{0, 0, 1, 1});
-    markDirty(QSGNode::DirtyGeometry);
-
-    auto minDimension = qMin(m_rect.width(), m_rect.height());
-
-    QVector2D aspect{1.0, 1.0};
-    aspect.setX(rect.width() / minDimension);
-    aspect.setY(rect.height() / minDimension);
-    m_material->setAspectRatio(aspect);
-
-    m_material->setInnerRadius(m_innerRadius / minDimension);
-    m_material->setOuterRadius(m_outerRadius / minDimension);
-
-    markDirty(QSGNode::DirtyMaterial);
+    m_geometryDirty = true;
+    m_ringsDirty = true;
 }
 
-void PieChartNode::setInnerRadius(qreal radius)
+void PieChartNode::setRingCount(int count)
 {
-    if (qFuzzyCompare(radius, m_innerRadius)) {
+    if (count == m_rings.size()) {
         return;
     }
 
-    m_innerRadius = radius;
-
-    auto minDimension = qMin(m_rect.width(), m_rect.height());
-    m_material->setInnerRadius(m_innerRadius / minDimension);
-
-    markDirty(QSGNode::DirtyMaterial);
+    m_rings.resize(count);
+    m_ringsDirty = true;
 }
 
-void PieChartNode::setOuterRadius(qreal radius)
+void PieChartNode::setInnerRadius(int ring, qreal radius)
 {
-    if (qFuzzyCompare(radius, m_outerRadius)) {
+    if (ring < 0 || ring >= m_rings.size() || qFuzzyCompare(radius, m_rings.at(ring).innerRadius)) {
         return;
     }
 
-    m_outerRadius = radius;
+    m_rings[ring].innerRadius = radius;
+    m_ringsDirty = true;
+}
 
-    auto minDimension = qMin(m_rect.width(), m_rect.height());
-    m_material->setOuterRadius(m_outerRadius / minDimension);
+void PieChartNode::setOuterRadius(int ring, qreal radius)
+{
+    if (ring < 0 || ring >= m_rings.size() || qFuzzyCompare(radius, m_rings.at(ring).outerRadius)) {
+        return;
+    }
 
-    markDirty(QSGNode::DirtyMaterial);
+    m_rings[ring].outerRadius = radius;
+    m_ringsDirty = true;
 }
 
-void PieChartNode::setColors(const QVector<QColor> &colors)
+void PieChartNode::setColors(int ring, const QVector<QColor> &colors)
 {
-    m_colors = colors;
-    updateTriangles();
+    if (ring < 0 || ring >= m_rings.size() || colors == m_rings.at(ring).colors) {
+        return;
+    }
+
+    m_rings[ring].colors = colors;
+    m_ringsDirty = true;
 }
 
-void PieChartNode::setSections(const QVector<qreal> &sections)
+void PieChartNode::setSections(int ring, const QVector<qreal> &sections)
 {
-    m_sections = sections;
-    updateTriangles();
+    if (ring < 0 || ring >= m_rings.size() || sections == m_rings.at(ring).sections) {
+        return;
+    }
+
+    m_rings[ring].sections = sections;
+    m_ringsDirty = true;
 }
 
 void PieChartNode::setBackgroundColor(const QColor &color)
@@ -138,11 +137,10 @@ void PieChartNode::setBackgroundColor(const QColor &color)
         return;
 
     m_backgroundColor = color;
-    if (qFuzzyCompare(m_toAngle, 360.0)) {
-        m_material->setBackgroundColor(color);
-        markDirty(QSGNode::DirtyMaterial);
-    } else {
-        updateTriangles();
+    m_materialDirty = true;
+    // When not covering the full circle, the background is rendered as an extra segment.
+    if (!qFuzzyCompare(m_toAngle, 360.0)) {
+        m_ringsDirty = true;
     }
 }
 
@@ -153,24 +151,18 @@ void PieChartNode::setFromAngle(qreal angle)
     }
 
     m_fromAngle = angle;
-    updateTriangles();
+    m_ringsDirty = true;
 }
 
 void PieChartNode::setToAngle(qreal angle)
 {
-    if (qFuzzyCompare(angle, m_fromAngle)) {
+    if (qFuzzyCompare(angle, m_toAngle)) {
         return;
     }
 
     m_toAngle = angle;
-
-    if (!qFuzzyCompare(m_toAngle, 360.0)) {
-        m_material->setBackgroundColor(Qt::transparent);
-    } else {
-        m_material->setBackgroundColor(m_backgroundColor);
-    }
-
-    updateTriangles();
+    m_materialDirty = true;
+    m_ringsDirty = true;
 }
 
 void PieChartNode::setSmoothEnds(bool smooth)
@@ -180,25 +172,148 @@ void PieChartNode::setSmoothEnds(bool smooth)
     }
 
     m_smoothEnds = smooth;
-    m_material->setSmoothEnds(smooth);
-    markDirty(QSGNode::DirtyMaterial);
+    m_materialDirty = true;
+    m_ringsDirty = true;
 }
 
-void PieChartNode::updateTriangles()
+void PieChartNode::commit()
 {
-    if (m_sections.isEmpty() || m_sections.size() != m_colors.size())
-        return;
+    if (m_ringsDirty) {
+        updateRings();
+    }
+
+    if (m_geometryDirty) {
+        auto minDimension = qMin(m_rect.width(), m_rect.height());
+
+        QVector2D aspect{1.0, 1.0};
+        aspect.setX(m_rect.width() / minDimension);
+        aspect.setY(m_rect.height() / minDimension);
+
+        for (auto batch : qAsConst(m_batches)) {
+            QSGGeometry::updateTexturedRectGeometry(batch->geometry(), m_rect, QRectF{0, 0, 1, 1});
+            batch->markDirty(QSGNode::DirtyGeometry);
+            static_cast<PieChartMaterial *>(batch->material())->setAspectRatio(aspect);
+        }
+        m_materialDirty = true;
+    }
+
+    if (m_materialDirty) {
+        for (auto batch : qAsConst(m_batches)) {
+            auto material = static_cast<PieChartMaterial *>(batch->material());
+            material->setBackgroundColor(qFuzzyCompare(m_toAngle, 360.0) ? m_backgroundColor : QColor(Qt::transparent));
+            material->setSmoothEnds(m_smoothEnds);
+            batch->markDirty(QSGNode::DirtyMaterial);
+        }
+    }
+
+    m_geometryDirty = false;
+    m_materialDirty = false;
+    m_ringsDirty = false;
+}
+
+void PieChartNode::updateRings()
+{
+    struct Batch {
+        QVector<QVector2D> radii;
+        QVector<int> ringSegments;
+        QVector<QVector2D> trianglePoints;
+        QVector<QVector4D> triangleColors;
+        QVector<int> segments;
+    };
 
-    QVector<QVector2D> trianglePoints;
-    QVector<QVector4D> triangleColors;
-    QVector<int> segments;
+    auto minDimension = qMin(m_rect.width(), m_rect.height());
+
+    QVector<Batch> batches;
+    auto skippedRings = 0;
+
+    for (const auto &ring : qAsConst(m_rings)) {
+        QVector<QVector2D> ringPoints;
+        QVector<QVector4D> ringColors;
+        QVector<int> ringSegmentSizes;
+
+        ringTriangles(ring, ringPoints, ringColors, ringSegmentSizes);
+
+        // A ring that does not fit in the uniform arrays by itself cannot be
+        // rendered at all.
+        if (ringSegmentSizes.size() > MaximumSegments || ringPoints.size() > MaximumSegments * 2) {
+            skippedRings++;
+            continue;
+        }
+
+        // Otherwise, start a new batch once the current one is full.
+        if (batches.isEmpty() || batches.last().radii.size() >= MaximumRings
+            || batches.last().segments.size() + ringSegmentSizes.size() > MaximumSegments
+            || batches.last().trianglePoints.size() + ringPoints.size() > MaximumSegments * 2) {
+            batches << Batch{};
+        }
+
+        auto &batch = batches.last();
+        if (minDimension > 0.0) {
+            batch.radii << QVector2D(ring.innerRadius / minDimension, ring.outerRadius / minDimension);
+        } else {
+            batch.radii << QVector2D{};
+        }
+        batch.ringSegments << ringSegmentSizes.size();
+        batch.trianglePoints << ringPoints;
+        batch.triangleColors << ringColors;
+        batch.segments << ringSegmentSizes;
+    }
+
+    if (skippedRings > 0) {
+        qWarning() << "PieChart: Too many sections to render," << skippedRings << "of" << m_rings.size()
+                   << "rings will not be displayed. Each ring is limited to" << MaximumSegments << "sections.";
+    }
+
+    updateBatchCount(batches.size());
+
+    for (int i = 0; i < batches.size(); ++i) {
+        const auto &batch = batches.at(i);
+        auto material = static_cast<PieChartMaterial *>(m_batches.at(i)->material());
+        material->setRings(batch.radii);
+        material->setRingSegments(batch.ringSegments);
+        material->setTriangles(batch.trianglePoints);
+        material->setColors(batch.triangleColors);
+        material->setSegments(batch.segments);
+        m_batches.at(i)->markDirty(QSGNode::DirtyMaterial);
+    }
+}
+
+void PieChartNode::updateBatchCount(int count)
+{
+    while (m_batches.size() < count) {
+        auto batch = new QSGGeometryNode{};
+
+        auto geometry = new QSGGeometry{QSGGeometry::defaultAttributes_TexturedPoint2D(), 4};
+        batch->setGeometry(geometry);
+        batch->setMaterial(new PieChartMaterial{});
+        batch->setFlags(QSGNode::OwnsGeometry | QSGNode::OwnsMaterial);
+
+        m_batches << batch;
+        appendChildNode(batch);
+
+        // A new batch needs everything else to be set as well.
+        m_geometryDirty = true;
+        m_materialDirty = true;
+    }
+
+    while (m_batches.size() > count) {
+        auto batch = m_batches.takeLast();
+        removeChildNode(batch);
+        delete batch;
+    }
+}
+
+void PieChartNode::ringTriangles(const Ring &ring, QVector<QVector2D> &trianglePoints, QVector<QVector4D> &triangleColors, QVector<int> &segments)
+{
+    const auto &sections = ring.sections;
+    const auto &colors = ring.colors;
+
+    if (sections.isEmpty() || sections.size() != colors.size())
+        return;
 
     qreal totalAngle = degToRad(m_toAngle);
     qreal overlap = m_smoothEnds ? 0.2 : 0.05;
 
-    auto sections = m_sections;
-    auto colors = m_colors;
-
     QVector2D point = rotated(QVector2D{0.0, -2.0}, degToRad(m_fromAngle));
     auto index = 0;
     auto current = sections.at(0) * totalAngle;
@@ -262,10 +377,4 @@ void PieChartNode::updateTriangles()
         triangleColors.prepend(colorToVec4(m_backgroundColor));
         segments.prepend(sectionCount);
     }
-
-    m_material->setTriangles(trianglePoints);
-    m_material->setColors(triangleColors);
-    m_material->setSegments(segments);
-
-    markDirty(QSGNode::DirtyMaterial);
 }
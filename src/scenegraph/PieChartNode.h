@@ -23,15 +23,21 @@
 #define PIECHARTNODE_H
 
 #include <QColor>
-#include <QSGGeometryNode>
+#include <QSGNode>
+#include <QVector2D>
+#include <QVector4D>
 
 class QRectF;
-class PieChartMaterial;
+class QSGGeometryNode;
 
 /**
- * @todo write docs
+ * A node that renders the rings of a pie chart using as few quads as possible.
+ *
+ * Rings are rendered in batches by a single quad each. A new batch is only
+ * started when the rings do not fit in the uniform arrays of the shader
+ * anymore, so most charts are rendered by a single quad.
  */
-class PieChartNode : public QSGGeometryNode
+class PieChartNode : public QSGNode
 {
 public:
     PieChartNode();
@@ -47,31 +53,49 @@ public:
     ~PieChartNode();
 
     void setRect(const QRectF &rect);
-    void setInnerRadius(qreal radius);
-    void setOuterRadius(qreal radius);
-    void setSections(const QVector<qreal> &sections);
-    void setColors(const QVector<QColor> &colors);
+    void setRingCount(int count);
+    void setInnerRadius(int ring, qreal radius);
+    void setOuterRadius(int ring, qreal radius);
+    void setSections(int ring, const QVector<qreal> &sections);
+    void setColors(int ring, const QVector<QColor> &colors);
     void setBackgroundColor(const QColor &color);
     void setFromAngle(qreal angle);
     void setToAngle(qreal angle);
     void setSmoothEnds(bool smooth);
 
+    /**
+     * Apply all changes made through the setters.
+     *
+     * The setters only record the new state, so this should be called once
+     * after all properties have been set.
+     */
+    void commit();
+
 private:
-    void updateTriangles();
+    struct Ring {
+        qreal innerRadius = 0.0;
+        qreal outerRadius = 0.0;
+        QVector<qreal> sections;
+        QVector<QColor> colors;
+    };
+
+    void updateRings();
+    void updateBatchCount(int count);
+    void ringTriangles(const Ring &ring, QVector<QVector2D> &trianglePoints, QVector<QVector4D> &triangleColors, QVector<int> &segments);
 
     QRectF m_rect;
-    qreal m_innerRadius = 0.0;
-    qreal m_outerRadius = 0.0;
     QColor m_backgroundColor;
     qreal m_fromAngle = 0.0;
     qreal m_toAngle = 360.0;
     bool m_smoothEnds = false;
 
-    QVector<qreal> m_sections;
-    QVector<QColor> m_colors;
+    QVector<Ring> m_rings;
+
+    bool m_geometryDirty = false;
+    bool m_materialDirty = false;
+    bool m_ringsDirty = false;
 
-    QSGGeometry *m_geometry = nullptr;
-    PieChartMaterial *m_material = nullptr;
+    QVector<QSGGeometryNode *> m_batches;
 };
 
 #endif // PIECHARTNODE_H
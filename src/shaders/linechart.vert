@@ -20,17 +20,17 @@
  */
 
 uniform highp mat4 matrix;
-uniform lowp float lineWidth;
-uniform lowp float aspect;
 
 attribute highp vec4 in_vertex;
-attribute mediump vec2 in_uv;
+attribute lowp vec4 in_color;
+// x is the distance from the center of the line, y is half the line width.
+attribute mediump vec2 in_edge;
 
-varying mediump vec2 uv;
+varying lowp vec4 color;
+varying mediump vec2 edge;
 
 void main() {
-    uv.x = in_uv.x;
-    uv.y = in_uv.y;
-    uv.y = (1.0 + -1.0 * uv.y) * aspect;
+    color = in_color;
+    edge = in_edge;
     gl_Position = matrix * in_vertex;
 }
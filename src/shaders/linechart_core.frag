@@ -21,29 +21,16 @@
 
 // This requires "sdf_core.frag" which is included through SDFShader.
 
-uniform float opacity;
-uniform vec4 lineColor;
-uniform vec4 fillColor;
-uniform float lineWidth;
+uniform float opacity; // inherited opacity of this item
 
-uniform vec2 points[SDF_POLYGON_MAX_POINT_COUNT];
-uniform int pointCount;
-
-in vec2 uv;
+in vec4 color;
+in vec2 edge;
 
 out vec4 out_color;
 
 void main()
 {
-    vec2 point = uv;
-
-    vec4 color = vec4(0.0, 0.0, 0.0, 0.0);
-
-    float polygon = sdf_polygon(point, points, pointCount);
-
-    color = sdf_render(polygon, color, fillColor, 0.001);
-
-    color = sdf_render(sdf_annular(sdf_outline(polygon), lineWidth), color, lineColor, 0.0004);
-
-    out_color = color * opacity;
+    // Fade out over a single pixel at the edge of the line.
+    float coverage = clamp(edge.y + 0.5 - abs(edge.x), 0.0, 1.0);
+    out_color = color * coverage * opacity;
 }
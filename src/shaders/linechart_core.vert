@@ -20,17 +20,17 @@
  */
 
 uniform mat4 matrix;
-uniform float lineWidth;
-uniform float aspect;
 
 in vec4 in_vertex;
-in vec2 in_uv;
+in vec4 in_color;
+// x is the distance from the center of the line, y is half the line width.
+in vec2 in_edge;
 
-out vec2 uv;
+out vec4 color;
+out vec2 edge;
 
 void main() {
-    uv.x = in_uv.x;
-    uv.y = in_uv.y;
-    uv.y = (1.0 + -1.0 * uv.y) * aspect;
+    color = in_color;
+    edge = in_edge;
     gl_Position = matrix * in_vertex;
 }
@@ -21,23 +21,31 @@
 
 // This requires "sdf_core.frag" which is included through SDFShader.
 
-// The maximum number of segments we can support for a single pie.
+// The maximum number of segments we can support for all rings rendered by a
+// single quad. Rings that do not fit are rendered by another quad.
 // This is based on OpenGL's MAX_FRAGMENT_UNIFORM_COMPONENTS.
 // MAX_FRAGMENT_UNIFORM_COMPONENTS is required to be at least 1024.
 // Assuming a segment of size 1, each segment needs
 // 2 (size of a vec2) * 2 (number of points) + 4 (size of vec4) + 1 (segment size)
 // components. We also need to leave some room for the other uniforms.
 #define MAX_SEGMENTS 100
+// The maximum number of rings we can render in a single pass. Each ring needs
+// 2 (size of a vec2) + 1 (ring segment count) components.
+#define MAX_RINGS 16
 
 uniform float opacity;
-uniform float innerRadius;
-uniform float outerRadius;
 uniform vec4 backgroundColor;
+uniform bool smoothEnds;
+
+// The inner (x) and outer (y) radius of each ring.
+uniform vec2 rings[MAX_RINGS];
+// The number of entries in segments and colors that belong to each ring.
+uniform int ringSegments[MAX_RINGS];
+uniform int ringCount;
 
 uniform vec2 triangles[MAX_SEGMENTS * 2];
 uniform vec4 colors[MAX_SEGMENTS];
 uniform int segments[MAX_SEGMENTS];
-uniform int segmentCount;
 
 in vec2 uv;
 
@@ -50,25 +58,44 @@ void main()
 {
     vec2 point = uv * (1.0 + lineSmooth * 2.0);
 
-    float thickness = (outerRadius - innerRadius) / 2.0;
-    float donut = sdf_annular(sdf_circle(point, innerRadius + thickness), thickness);
-
     vec4 color = vec4(0.0);
-    float totalSegments = sdf_null;
-    int index = 0;
+    int segmentIndex = 0;
+    int triangleIndex = 0;
+
+    for (int r = 0; r < ringCount && r < MAX_RINGS; ++r) {
+        float thickness = (rings[r].y - rings[r].x) / 2.0;
+        float donut = sdf_annular(sdf_circle(point, rings[r].x + thickness), thickness);
+
+        vec4 ringColor = vec4(0.0);
+        float totalSegments = sdf_null;
+
+        for (int i = 0; i < ringSegments[r] && segmentIndex < MAX_SEGMENTS; ++i) {
+            float segment = sdf_null;
+            for(int j = 0; j < segments[segmentIndex] && j < MAX_SEGMENTS; j++) {
+                segment = sdf_union(segment, sdf_round(sdf_triangle(point, origin, triangles[triangleIndex++], triangles[triangleIndex++]), lineSmooth));
+            }
+            totalSegments = sdf_union(totalSegments, segment);
 
-    for (int i = 0; i < segmentCount && i < MAX_SEGMENTS; ++i) {
-        float segment = sdf_null;
-        for(int j = 0; j < segments[i] && j < MAX_SEGMENTS; j++) {
-            segment = sdf_union(segment, sdf_round(sdf_triangle(point, origin, triangles[index++], triangles[index++]), lineSmooth));
+            segment = smoothEnds
+                      ? sdf_intersect_smooth(donut, segment, thickness)
+                      : sdf_intersect(donut, segment);
+
+            ringColor = sdf_render(segment, ringColor, colors[segmentIndex], lineSmooth);
+            segmentIndex++;
         }
-        totalSegments = sdf_union(totalSegments, segment);
-        color = sdf_render(sdf_intersect(donut, segment), color, colors[i], lineSmooth);
-    }
 
-    // Finally, render an end segment with the background color.
-    float segment = sdf_subtract(sdf_round(donut, lineSmooth), totalSegments);
-    color = sdf_render(segment, color, backgroundColor, lineSmooth);
+        // Finally, render an end segment with the background color.
+        if (smoothEnds) {
+            vec4 background = sdf_render(donut, vec4(0.0), backgroundColor, lineSmooth);
+            ringColor = mix(background, ringColor, ringColor.a);
+        } else {
+            float segment = sdf_subtract(sdf_round(donut, lineSmooth), totalSegments);
+            ringColor = sdf_render(segment, ringColor, backgroundColor, lineSmooth);
+        }
+
+        // Rings do not overlap, so this only blends the anti-aliased edges.
+        color = mix(color, ringColor, ringColor.a);
+    }
 
     out_color = color * opacity;
 }